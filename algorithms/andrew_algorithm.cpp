@@ -1,11 +1,16 @@
 #include "andrew_algorithm.h"
 #include <algorithm>
+#include <bit>
 #include <iostream>
 
 using core::Point;
 
 void AndrewAlgorithm::reset(const std::vector<Point>& pts) {
-    points_ = pts;
+    reset(std::vector<Point>(pts));
+}
+
+void AndrewAlgorithm::reset(std::vector<Point>&& pts) {
+    points_ = std::move(pts);
     order_.clear();
     frames_.clear();
     frame_pos_ = 0;
@@ -15,16 +20,17 @@ void AndrewAlgorithm::reset(const std::vector<Point>& pts) {
 void AndrewAlgorithm::build_sorted_order() {
     const int n = static_cast<int>(points_.size());
     order_.resize(n);
-    for (int i = 0; i < n; ++i) order_[i] = i;
-
-    std::sort(order_.begin(), order_.end(), [&](int i, int j) {
-        return less_xy(points_[i], points_[j]);
+    sliced("sort", order_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) order_[i] = static_cast<int>(i);
     });
 
+    sort_adaptive();
+
     // remove exact duplicates
     std::vector<int> uniq;
     uniq.reserve(order_.size());
     for (std::size_t k = 0; k < order_.size(); ++k) {
+        if (k % kCheckEvery == 0) checkpoint("dedupe", k, order_.size());
         if (k == 0) { uniq.push_back(order_[k]); continue; }
         const Point& p = points_[order_[k]];
         const Point& q = points_[uniq.back()];
@@ -33,6 +39,135 @@ void AndrewAlgorithm::build_sorted_order() {
     order_.swap(uniq);
 }
 
+void AndrewAlgorithm::sort_adaptive() {
+    auto less = [&](int i, int j) { return less_xy(points_[i], points_[j]); };
+    auto less_x = [&](int i, int j) { return points_[i].x < points_[j].x; };
+    const std::size_t n = order_.size();
+
+    // progress counts passes over the input, the scan or the slice sort, one
+    // per level of merges and the tie fix up. checks come every kCheckEvery
+    // elements moved, comparisons are not counted
+    std::size_t work = 0;
+    std::size_t stages = 2;
+    auto check = [&](std::size_t len) { tick(len, "sort", std::min(n, work / stages), n); };
+    auto advance = [&](std::size_t len) {
+        work += len;
+        check(len);
+    };
+
+    // one scan for maximal runs in x, ascending or descending. runs only look
+    // at x since points along a curve often tie in x with y going either way,
+    // the ties are put in order afterwards. random input gives up after
+    // kMaxRuns runs, a few elements in, and is cut into sorted slices instead
+    std::vector<std::size_t> starts;
+    std::vector<bool> descending;
+    std::size_t i = 0;
+    while (i < n) {
+        if (starts.size() == kMaxRuns) {
+            starts.clear();
+            descending.clear();
+            for (std::size_t begin = 0; begin < n; begin += kCheckEvery) {
+                const std::size_t end = std::min(n, begin + kCheckEvery);
+                std::sort(order_.begin() + begin, order_.begin() + end, less);
+                starts.push_back(begin);
+                descending.push_back(false);
+                advance(end - begin);
+            }
+            break;
+        }
+        starts.push_back(i);
+        std::size_t j = i + 1;
+        while (j < n && !less_x(order_[j], order_[j - 1]) && !less_x(order_[j - 1], order_[j])) ++j;
+        const bool down = j < n && less_x(order_[j], order_[j - 1]);
+        if (down) {
+            while (j < n && !less_x(order_[j - 1], order_[j])) ++j;
+        } else {
+            while (j < n && !less_x(order_[j], order_[j - 1])) ++j;
+        }
+        descending.push_back(down);
+        advance(j - i);
+        i = j;
+    }
+    stages = 2 + static_cast<std::size_t>(std::bit_width(std::max<std::size_t>(1, starts.size()) - 1));
+    starts.push_back(n);
+
+    for (std::size_t r = 0; r + 1 < starts.size(); ++r) {
+        if (!descending[r]) continue;
+        std::reverse(order_.begin() + starts[r], order_.begin() + starts[r + 1]);
+        check(starts[r + 1] - starts[r]);
+    }
+
+    // a stable merge of [a, a + la) and [b, b + lb) in slices of kCheckEvery
+    // outputs. the split of the first k outputs is found by binary search,
+    // the largest i with a[i - 1] not after b[k - i]
+    auto merge = [&](const int* a, std::size_t la, const int* b, std::size_t lb, int* out) {
+        auto split = [&](std::size_t k) {
+            std::size_t lo = k > lb ? k - lb : 0;
+            std::size_t hi = std::min(k, la);
+            while (lo < hi) {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (!less_x(b[k - mid - 1], a[mid])) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo;
+        };
+        std::size_t k0 = 0;
+        std::size_t i0 = 0;
+        while (k0 < la + lb) {
+            const std::size_t k1 = std::min(la + lb, k0 + kCheckEvery);
+            const std::size_t i1 = split(k1);
+            std::merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), out + k0, less_x);
+            advance(k1 - k0);
+            k0 = k1;
+            i0 = i1;
+        }
+    };
+
+    // bottom up pairwise merge of the runs, ping pong between two buffers
+    if (starts.size() > 2) {
+        std::vector<int> buf;
+        buf.reserve(n);
+        for (std::size_t end = 0; end < n;) {
+            const std::size_t len = std::min(n - end, kCheckEvery);
+            end += len;
+            buf.resize(end);
+            check(len);
+        }
+        std::vector<int>* src = &order_;
+        std::vector<int>* dst = &buf;
+        while (starts.size() > 2) {
+            std::vector<std::size_t> next;
+            next.reserve(starts.size() / 2 + 2);
+            std::size_t r = 0;
+            for (; r + 2 < starts.size(); r += 2) {
+                merge(src->data() + starts[r], starts[r + 1] - starts[r],
+                      src->data() + starts[r + 1], starts[r + 2] - starts[r + 1],
+                      dst->data() + starts[r]);
+                next.push_back(starts[r]);
+            }
+            if (r + 1 < starts.size()) {
+                // odd run out, carried over as is
+                std::copy(src->begin() + starts[r], src->begin() + starts[r + 1], dst->begin() + starts[r]);
+                advance(starts[r + 1] - starts[r]);
+                next.push_back(starts[r]);
+            }
+            next.push_back(n);
+            starts.swap(next);
+            std::swap(src, dst);
+        }
+        if (src != &order_) order_.swap(buf);
+    }
+
+    // order every group of equal x by y
+    for (std::size_t g = 0; g < n;) {
+        std::size_t e = g + 1;
+        while (e < n && points_[order_[e]].x == points_[order_[g]].x) ++e;
+        if (e - g > 1) std::sort(order_.begin() + g, order_.begin() + e, less);
+        advance(e - g);
+        g = e;
+    }
+}
+
 std::vector<int> AndrewAlgorithm::run_full() {
     build_sorted_order();
     const int m = static_cast<int>(order_.size());
@@ -45,7 +180,9 @@ std::vector<int> AndrewAlgorithm::run_full() {
     // lower chain from L to R
     std::vector<int> lower;
     lower.reserve(m);
-    for (int idx : order_) {
+    for (int k = 0; k < m; ++k) {
+        if (static_cast<std::size_t>(k) % kCheckEvery == 0) checkpoint("lower chain", static_cast<std::size_t>(k), static_cast<std::size_t>(m));
+        const int idx = order_[k];
         while (static_cast<int>(lower.size()) >= 2) {
             int a = lower[static_cast<int>(lower.size()) - 2];
             int b = lower[static_cast<int>(lower.size()) - 1];
@@ -65,6 +202,8 @@ std::vector<int> AndrewAlgorithm::run_full() {
     std::vector<int> upper;
     upper.reserve(m);
     for (int k = m - 1; k >= 0; --k) {
+        const auto done = static_cast<std::size_t>(m - 1 - k);
+        if (done % kCheckEvery == 0) checkpoint("upper chain", done, static_cast<std::size_t>(m));
         int idx = order_[k];
         if (in_lower[idx] && idx != L) continue; // skip reused interior points
 
@@ -12,11 +12,13 @@ public:
     const char* name() const override { return "Andrew"; }
 
     void reset(const std::vector<core::Point>& pts) override;
+    void reset(std::vector<core::Point>&& pts) override;
     std::vector<int> run_full() override;
 
     void begin_stepping() override;
     bool step() override;
     const core::HullFrame& frame() const override { return fr_; };
+    std::size_t frame_count() const override { return frames_.size(); }
 
 private:
     std::vector<core::Point> points_;
@@ -42,6 +44,13 @@ private:
     }
 
     void build_sorted_order();
+
+    // sort order_ by x then y. input that is already made of a few runs
+    // ascending or descending in x is merged in O(n log runs), anything
+    // else is sorted in slices of kCheckEvery that are merged the same way.
+    // plain and cancellable runs take the same path, ticking between slices
+    void sort_adaptive();
+    static constexpr std::size_t kMaxRuns = 32;
     static void append_no_dup(std::vector<int>& out, const std::vector<int>& part);
 
     // build the entire sequence of visual frames in frames_
@@ -0,0 +1,136 @@
+#include "algorithms/approx_hull.h"
+#include "algorithms/andrew_algorithm.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+using core::Point;
+
+namespace {
+    // diamond angle of (dx, dy) in [0, 4], monotone in the real angle. a
+    // quarter turn maps to 1, and a stretch of it is at most twice as wide in
+    // radians as in pseudo angle. written without branches, the quadrant of
+    // random input is a coin flip for the branch predictor
+    inline float pseudo_angle(float dx, float dy) {
+        const float t = dy / (std::fabs(dx) + std::fabs(dy) + 1e-30f);
+        const float sign = std::copysign(1.0f, dx);
+        const float wrap = static_cast<float>((dx >= 0.0f) & (dy < 0.0f)) * 4.0f;
+        return (1.0f - sign) + sign * t + wrap;
+    }
+
+    // radians of a pseudo angle
+    double real_angle(double a) {
+        const double q = std::floor(a);
+        const double f = a - q;
+        return q * std::numbers::pi / 2.0 + std::atan2(f, 1.0 - f);
+    }
+
+    struct Extremes {
+        float min_x{std::numeric_limits<float>::infinity()};
+        float max_x{-std::numeric_limits<float>::infinity()};
+        float min_y{std::numeric_limits<float>::infinity()};
+        float max_y{-std::numeric_limits<float>::infinity()};
+        std::array<int, 4> ids{-1, -1, -1, -1};  // min x, max x, min y, max y
+    };
+
+    constexpr std::size_t kSample = 4096;
+}
+
+ApproxHull::ApproxHull(double epsilon) {
+    if (!(epsilon > 0.0)) throw std::runtime_error("approximate hull needs a positive epsilon");
+    if (epsilon < min_epsilon()) throw std::runtime_error("approximate hull epsilon is finer than its sectors can keep");
+    // points are at most the diagonal away from a center inside the box and
+    // a sector is at most 8 / sectors radians wide, so this many keep
+    // r sin(a) under epsilon times the diagonal
+    sectors_ = std::clamp(static_cast<int>(std::ceil(8.0 / epsilon)), 8, kMaxSectors);
+}
+
+ApproxHullResult ApproxHull::run(const std::vector<Point>& pts) const {
+    ApproxHullResult res;
+    res.sectors = sectors_;
+    const std::size_t n = pts.size();
+    if (n == 0) return res;
+
+    // center, the middle of the bounding box of an even sample. it lies in
+    // the hull of the sample's four points extreme in x and y, which join
+    // the candidates, so it is inside the result
+    const std::size_t stride = std::max<std::size_t>(1, n / kSample);
+    Extremes box;
+    for (std::size_t i = 0; i < n; i += stride) {
+        const Point& p = pts[i];
+        const int id = static_cast<int>(i);
+        if (p.x < box.min_x) { box.min_x = p.x; box.ids[0] = id; }
+        if (p.x > box.max_x) { box.max_x = p.x; box.ids[1] = id; }
+        if (p.y < box.min_y) { box.min_y = p.y; box.ids[2] = id; }
+        if (p.y > box.max_y) { box.max_y = p.y; box.ids[3] = id; }
+    }
+    const float cx = 0.5f * box.min_x + 0.5f * box.max_x;
+    const float cy = 0.5f * box.min_y + 0.5f * box.max_y;
+
+    // the one pass, the farthest point from the center in every sector. a
+    // block of sectors and distances is computed branch free first, then
+    // folded into the worker's table
+    const std::size_t chunks = core::chunk_count(n);
+    const int k = sectors_;
+    const float scale = static_cast<float>(k) / 4.0f;
+    std::vector<float> far_d2(chunks * static_cast<std::size_t>(k), -1.0f);
+    std::vector<int> far_id(chunks * static_cast<std::size_t>(k), -1);
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        constexpr std::size_t kBlock = 1024;
+        std::array<int, kBlock> sector{};
+        std::array<float, kBlock> d2{};
+        float* best = far_d2.data() + static_cast<std::size_t>(w) * k;
+        int* who = far_id.data() + static_cast<std::size_t>(w) * k;
+        for (std::size_t base = begin; base < end; base += kBlock) {
+            const std::size_t len = std::min(kBlock, end - base);
+            for (std::size_t j = 0; j < len; ++j) {
+                const float dx = pts[base + j].x - cx;
+                const float dy = pts[base + j].y - cy;
+                sector[j] = std::min(k - 1, static_cast<int>(pseudo_angle(dx, dy) * scale));
+                d2[j] = dx * dx + dy * dy;
+            }
+            for (std::size_t j = 0; j < len; ++j) {
+                if (d2[j] > best[sector[j]]) {
+                    best[sector[j]] = d2[j];
+                    who[sector[j]] = static_cast<int>(base + j);
+                }
+            }
+        }
+    });
+
+    // merge the workers' tables, bound the error per sector
+    std::vector<Point> cand;
+    cand.reserve(static_cast<std::size_t>(k) + 4);
+    for (int id : box.ids) {
+        Point p = pts[id];
+        p.id = id;
+        cand.push_back(p);
+    }
+    for (int s = 0; s < k; ++s) {
+        float d2 = -1.0f;
+        int id = -1;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            const std::size_t at = c * static_cast<std::size_t>(k) + s;
+            if (far_d2[at] > d2) { d2 = far_d2[at]; id = far_id[at]; }
+        }
+        if (id < 0) continue;
+        Point p = pts[id];
+        p.id = id;
+        cand.push_back(p);
+
+        // a point in the sector makes an angle of at most its width with the
+        // kept one, and the segment from the center to that one is in the hull
+        const double width = real_angle((s + 1) / scale) - real_angle(s / scale);
+        const double r = std::hypot(static_cast<double>(p.x) - cx, static_cast<double>(p.y) - cy);
+        res.error = std::max(res.error, width < std::numbers::pi / 2.0 ? r * std::sin(width) : r);
+    }
+
+    AndrewAlgorithm exact;
+    exact.reset(cand);
+    for (int i : exact.run_full()) res.hull.push_back(cand[i].id);
+    return res;
+}
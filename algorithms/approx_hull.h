@@ -0,0 +1,40 @@
+#ifndef ALGORITHMS_APPROX_HULL_H
+#define ALGORITHMS_APPROX_HULL_H
+
+#include <vector>
+#include "core/types.h"
+
+struct ApproxHullResult {
+    std::vector<int> hull;  // CCW indices into the input, every vertex an input point
+    double error{0.0};      // no input point is farther than this from the hull
+    int sectors{0};
+};
+
+// hull within epsilon times the bounding box diagonal of the exact one, in
+// one parallel pass over the points. the plane around a center taken from a
+// sample is split into sectors of pseudo angle, and the farthest point of
+// each is kept. their hull contains the center, so every input point is
+// within r sin(a) of it, r the farthest distance in its sector and a the
+// sector's angle. the result reports the largest such bound. the
+// approximate hull is inside the exact one, so that bound is also a bound on
+// the Hausdorff distance between the two. the sector count is bounded, so
+// an epsilon below min_epsilon() is refused rather than quietly missed
+class ApproxHull {
+public:
+    // finer sectors are below what a float pseudo angle resolves, and every
+    // worker keeps a table of this many entries
+    static constexpr int kMaxSectors = 1 << 20;
+
+    explicit ApproxHull(double epsilon = 1e-3);
+
+    static double min_epsilon() { return 8.0 / kMaxSectors; }
+
+    ApproxHullResult run(const std::vector<core::Point>& pts) const;
+
+    int sectors() const { return sectors_; }
+
+private:
+    int sectors_;
+};
+
+#endif
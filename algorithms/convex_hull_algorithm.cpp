@@ -4,3 +4,44 @@
 void ConvexHullAlgorithm::report(long long ns, int hull_size) const {
     std::cout << name() << ": " << ns << "ns," << " hull size: " << hull_size << std::endl;
 }
+
+std::vector<int> ConvexHullAlgorithm::run_cancellable(std::stop_token stop, ProgressFn progress) {
+    if (stop.stop_requested()) throw HullCancelled();
+
+    // cleared on the way out, also when cancelled, so later plain runs pay
+    // nothing for the checks
+    struct Restore {
+        ConvexHullAlgorithm& algo;
+        ~Restore() {
+            algo.stop_ = {};
+            algo.progress_ = nullptr;
+            algo.checks_ = {};
+        }
+    } restore{*this};
+    stop_ = std::move(stop);
+    progress_ = std::move(progress);
+    since_check_ = 0;
+    if (cancellable()) {
+        checks_.stop_fn = [this] { return stop_requested(); };
+        checks_.checkpoint_fn = [this](const char* phase, std::size_t done, std::size_t total) {
+            checkpoint(phase, done, total);
+        };
+    }
+    return run_full();
+}
+
+std::future<std::vector<int>> ConvexHullAlgorithm::run_async(std::stop_token stop, ProgressFn progress) {
+    return std::async(std::launch::async, [this, stop = std::move(stop), progress = std::move(progress)]() mutable {
+        return run_cancellable(std::move(stop), std::move(progress));
+    });
+}
+
+void ConvexHullAlgorithm::checkpoint(const char* phase, std::size_t done, std::size_t total) const {
+    if (stop_.stop_requested()) throw HullCancelled();
+    if (progress_) progress_(HullProgress{phase, done, total});
+}
+
+std::vector<int> ConvexHullAlgorithm::run_nested(ConvexHullAlgorithm& inner) const {
+    if (!cancellable()) return inner.run_full();
+    return inner.run_cancellable(stop_, progress_);
+}
@@ -1,28 +1,112 @@
 #ifndef ALGORITHMS_CONVEX_HULL_ALGORITHM_H
 #define ALGORITHMS_CONVEX_HULL_ALGORITHM_H
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <stop_token>
 #include <vector>
+#include "core/checks.h"
 #include "core/types.h"
 
+// where a cancellable run is, passed to its progress callback. done and total
+// count points for the passes over the input, the phase says what else
+struct HullProgress {
+    const char* phase{""};
+    std::size_t done{0};
+    std::size_t total{0};
+};
+
+// thrown out of a cancellable run once its stop token is triggered
+class HullCancelled : public std::runtime_error {
+public:
+    HullCancelled() : std::runtime_error("hull run cancelled") {}
+};
+
 class ConvexHullAlgorithm {
 public:
+    using ProgressFn = std::function<void(const HullProgress&)>;
+
     virtual ~ConvexHullAlgorithm() = default;
 
     virtual const char* name() const = 0;
 
     // set input points. indices in all outputs refer to this array
     virtual void reset(const std::vector<core::Point>& pts) = 0;
+    // the same, taking over the caller's array where an algorithm keeps one
+    virtual void reset(std::vector<core::Point>&& pts) { reset(static_cast<const std::vector<core::Point>&>(pts)); }
 
     // compute full hull. return indices in CCW order without repeating the first point
     virtual std::vector<int> run_full() = 0;
 
+    // run_full on the calling thread, looking at stop between slices of at
+    // most kCheckEvery points or comparisons and throwing HullCancelled once
+    // it is triggered. progress is called from the same thread at the same
+    // places, it should return quickly. an algorithm without checks of its
+    // own only sees the token before it starts
+    std::vector<int> run_cancellable(std::stop_token stop, ProgressFn progress = {});
+
+    // run_cancellable on a thread of its own. get() gives the hull or
+    // rethrows HullCancelled. the algorithm must outlive the future and is
+    // not to be touched until it is ready
+    std::future<std::vector<int>> run_async(std::stop_token stop, ProgressFn progress = {});
+
     // stepping API for the visualizer
     virtual void begin_stepping() = 0;
     virtual bool step() = 0; // return false when finished
     virtual const core::HullFrame& frame() const = 0;
+    // frames begin_stepping produced, the first included
+    virtual std::size_t frame_count() const = 0;
 
     // optional reporting
     void report(long long ns, int hull_size) const;
+
+protected:
+    // points or comparisons between two looks at the stop token
+    static constexpr std::size_t kCheckEvery = core::kCheckEvery;
+
+    // inside run_cancellable with a token that can be triggered or a
+    // progress callback, for paths that are only worth checking then
+    bool cancellable() const { return stop_.stop_possible() || static_cast<bool>(progress_); }
+
+    // for parallel_chunks workers, which must not throw. they stop early and
+    // the caller checkpoints after the join
+    bool stop_requested() const { return stop_.stop_requested(); }
+
+    // throws HullCancelled once stop was requested, reports progress otherwise
+    void checkpoint(const char* phase, std::size_t done, std::size_t total) const;
+
+    // adds work and checkpoints once kCheckEvery of it piled up, for loops
+    // whose size is not known up front, like a recursion
+    void tick(std::size_t work, const char* phase, std::size_t done, std::size_t total) const {
+        since_check_ += work;
+        if (since_check_ < kCheckEvery) return;
+        since_check_ = 0;
+        checkpoint(phase, done, total);
+    }
+
+    // the token and callback as core::Checks, for code shared with the
+    // pipelines. empty outside a cancellable run
+    const core::Checks& checks() const { return checks_; }
+
+    // fn(begin, end) over [0, n), in slices of kCheckEvery with a checkpoint
+    // after each inside a cancellable run
+    template <class Fn>
+    void sliced(const char* phase, std::size_t n, Fn&& fn) const {
+        core::sliced(checks_, phase, n, std::forward<Fn>(fn));
+    }
+
+    // run_full of an algorithm this one hands its input to, under the same
+    // token and callback
+    std::vector<int> run_nested(ConvexHullAlgorithm& inner) const;
+
+private:
+    std::stop_token stop_;
+    ProgressFn progress_;
+    core::Checks checks_;
+    mutable std::size_t since_check_{0};
 };
 
 #endif
@@ -0,0 +1,286 @@
+#include "algorithms/grid_hull.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using core::Point;
+
+namespace {
+    bool less_xy(const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    // y of a chain sorted by x at every x in xs, ascending. a vertical edge,
+    // only possible at either end, gives its lower end for a lower chain and
+    // its upper end for an upper chain
+    std::vector<double> chain_at(const std::vector<Point>& chain, const std::vector<double>& xs, bool upper) {
+        std::vector<double> ys(xs.size());
+        const std::size_t m = chain.size();
+        std::size_t i = 0;
+        for (std::size_t k = 0; k < xs.size(); ++k) {
+            const double x = xs[k];
+            while (i + 2 < m && chain[i + 1].x < x) ++i;
+            const Point& a = chain[i];
+            const Point& b = chain[i + 1];
+            if (a.x == b.x) {
+                ys[k] = upper ? std::max(a.y, b.y) : std::min(a.y, b.y);
+                continue;
+            }
+            const double t = std::clamp((x - a.x) / (static_cast<double>(b.x) - a.x), 0.0, 1.0);
+            ys[k] = a.y + t * (static_cast<double>(b.y) - a.y);
+        }
+        return ys;
+    }
+}
+
+int GridHullAlgorithm::Grid::column(float x) const {
+    if (bounds.empty()) {
+        return static_cast<int>(std::clamp((x - x0) * inv_w, 0.0f, static_cast<float>(cols - 1)));
+    }
+    // x is in the column of its cell's left edge or at most that of the next
+    // cell's, dense stretches of columns get a binary search
+    const std::size_t cell = static_cast<std::size_t>(std::clamp((x - x0) * lut_scale, 0.0f, static_cast<float>(lut.size() - 1)));
+    const int lo = lut[cell];
+    const int hi = cell + 1 < lut.size() ? lut[cell + 1] : cols - 1;
+    // last column in [lo, hi] whose left edge is at most x, bounds[lo] is.
+    // written so the compiler can select instead of branch, the columns of
+    // skewed data are a coin flip each step
+    const float* b = bounds.data() + lo;
+    int len = hi - lo + 1;
+    while (len > 1) {
+        const int half = len / 2;
+        b = b[half] <= x ? b + half : b;
+        len -= half;
+    }
+    return static_cast<int>(b - bounds.data());
+}
+
+float GridHullAlgorithm::Grid::left(int c) const {
+    if (!bounds.empty()) return bounds[c];
+    return inv_w > 0.0f ? x0 + static_cast<float>(c) / inv_w : x0;
+}
+
+void GridHullAlgorithm::reset(const std::vector<Point>& pts) {
+    reset(std::vector<Point>(pts));
+}
+
+void GridHullAlgorithm::reset(std::vector<Point>&& pts) {
+    points_ = std::move(pts);
+    cand_.clear();
+    fr_ = core::HullFrame{};
+}
+
+GridHullAlgorithm::Grid GridHullAlgorithm::make_grid() const {
+    const std::size_t n = points_.size();
+    const std::size_t stride = std::max<std::size_t>(1, n / kSample);
+    std::vector<float> xs;
+    xs.reserve(n / stride + 1);
+    for (std::size_t i = 0; i < n; i += stride) xs.push_back(points_[i].x);
+    std::sort(xs.begin(), xs.end());
+
+    Grid g;
+    g.cols = static_cast<int>(std::clamp<std::size_t>(n / kPointsPerColumn, 1, xs.size()));
+    g.x0 = xs.front();
+    const float span = xs.back() - xs.front();
+    if (!(span > 0.0f)) {
+        g.cols = 1;
+        return g;
+    }
+
+    // a sample crowded into a few of 64 equal bins means skewed x, equal
+    // width columns would leave most of them empty and a few holding most
+    // points
+    constexpr int kBins = 64;
+    std::array<std::size_t, kBins> bins{};
+    for (float x : xs) ++bins[std::min(kBins - 1, static_cast<int>((x - g.x0) / span * kBins))];
+    const std::size_t crowded = *std::max_element(bins.begin(), bins.end());
+    if (crowded <= 4 * xs.size() / kBins) {
+        g.inv_w = static_cast<float>(g.cols) / span;
+        return g;
+    }
+
+    // quantile columns, with heavy repeats of one x collapsed into a single
+    // column. a lookup table of equal width cells narrows the search
+    g.bounds.reserve(g.cols);
+    for (int c = 0; c < g.cols; ++c) {
+        const float x = xs[static_cast<std::size_t>(c) * xs.size() / g.cols];
+        if (g.bounds.empty() || x > g.bounds.back()) g.bounds.push_back(x);
+    }
+    g.cols = static_cast<int>(g.bounds.size());
+    g.lut.resize(4 * static_cast<std::size_t>(g.cols));
+    g.lut_scale = static_cast<float>(g.lut.size()) / span;
+    for (std::size_t cell = 0; cell < g.lut.size(); ++cell) {
+        const float x = g.x0 + static_cast<float>(cell) / g.lut_scale;
+        const int c = static_cast<int>(std::upper_bound(g.bounds.begin(), g.bounds.end(), x) - g.bounds.begin()) - 1;
+        g.lut[cell] = std::max(0, c);
+    }
+    return g;
+}
+
+std::vector<int> GridHullAlgorithm::hull_of_candidates() {
+    std::vector<Point> sub;
+    sub.reserve(cand_.size());
+    sliced("candidates", cand_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) sub.push_back(points_[cand_[k]]);
+    });
+    chain_.reset(sub);
+    std::vector<int> hull = run_nested(chain_);
+    for (int& id : hull) id = cand_[id];
+    return hull;
+}
+
+std::vector<int> GridHullAlgorithm::reduce_and_hull() {
+    const std::size_t n = points_.size();
+    cand_.clear();
+    auto take_all = [&] {
+        cand_.resize(n);
+        for (std::size_t i = 0; i < n; ++i) cand_[i] = static_cast<int>(i);
+        return hull_of_candidates();
+    };
+    if (n < 8 * kPointsPerColumn) return take_all();
+
+    // pass one, lowest and highest point per column and thread, and the two
+    // x extremes
+    const Grid g = make_grid();
+    const std::size_t cols = static_cast<std::size_t>(g.cols);
+    const std::size_t chunks = core::chunk_count(n);
+    std::vector<float> lo_y(chunks * cols, std::numeric_limits<float>::infinity());
+    std::vector<float> hi_y(chunks * cols, -std::numeric_limits<float>::infinity());
+    std::vector<int> lo_id(chunks * cols, -1);
+    std::vector<int> hi_id(chunks * cols, -1);
+    std::vector<std::array<int, 2>> x_ends(chunks, {-1, -1});
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        float* lo = lo_y.data() + w * cols;
+        float* hi = hi_y.data() + w * cols;
+        int* lo_who = lo_id.data() + w * cols;
+        int* hi_who = hi_id.data() + w * cols;
+        int first = static_cast<int>(begin);
+        int last = static_cast<int>(begin);
+        for (std::size_t s = begin; s < end && !stop_requested(); s += kCheckEvery) {
+            const std::size_t e = std::min(end, s + kCheckEvery);
+            for (std::size_t i = s; i < e; ++i) {
+                const Point& p = points_[i];
+                const int c = g.column(p.x);
+                if (p.y < lo[c]) { lo[c] = p.y; lo_who[c] = static_cast<int>(i); }
+                if (p.y > hi[c]) { hi[c] = p.y; hi_who[c] = static_cast<int>(i); }
+                if (less_xy(p, points_[first])) first = static_cast<int>(i);
+                if (less_xy(points_[last], p)) last = static_cast<int>(i);
+            }
+        }
+        x_ends[w] = {first, last};
+    });
+    checkpoint("columns", n, n);
+
+    int first = x_ends[0][0];
+    int last = x_ends[0][1];
+    for (std::size_t w = 1; w < chunks; ++w) {
+        if (less_xy(points_[x_ends[w][0]], points_[first])) first = x_ends[w][0];
+        if (less_xy(points_[last], points_[x_ends[w][1]])) last = x_ends[w][1];
+    }
+    cand_.push_back(first);
+    cand_.push_back(last);
+    for (std::size_t c = 0; c < cols; ++c) {
+        int lo = -1;
+        int hi = -1;
+        for (std::size_t w = 0; w < chunks; ++w) {
+            const std::size_t at = w * cols + c;
+            if (lo_id[at] >= 0 && (lo < 0 || lo_y[at] < points_[lo].y)) lo = lo_id[at];
+            if (hi_id[at] >= 0 && (hi < 0 || hi_y[at] > points_[hi].y)) hi = hi_id[at];
+        }
+        if (lo >= 0) cand_.push_back(lo);
+        if (hi >= 0 && hi != lo) cand_.push_back(hi);
+    }
+    const std::vector<int> inner = hull_of_candidates();
+    // all on a line, the column test below needs an area to work with
+    if (inner.size() < 3) return take_all();
+
+    // lower chain from the lowest x to the highest, upper chain too after
+    // reversing its CCW order
+    const int h = static_cast<int>(inner.size());
+    int at_first = 0;
+    int at_last = 0;
+    for (int k = 0; k < h; ++k) {
+        if (less_xy(points_[inner[k]], points_[inner[at_first]])) at_first = k;
+        if (less_xy(points_[inner[at_last]], points_[inner[k]])) at_last = k;
+    }
+    std::vector<Point> lower;
+    std::vector<Point> upper;
+    for (int k = at_first;; k = (k + 1) % h) {
+        lower.push_back(points_[inner[k]]);
+        if (k == at_last) break;
+    }
+    for (int k = at_last;; k = (k + 1) % h) {
+        upper.push_back(points_[inner[k]]);
+        if (k == at_first) break;
+    }
+    std::reverse(upper.begin(), upper.end());
+
+    // the chains at every column edge. inside a column the upper chain is
+    // at least the lower of its two edge values and the lower chain at most
+    // the higher, so points strictly between those are inside. the margin
+    // covers the rounding of the interpolation
+    const double x_min = points_[first].x;
+    const double x_max = points_[last].x;
+    std::vector<double> edges(cols + 1);
+    for (std::size_t c = 0; c <= cols; ++c) {
+        const double x = c == 0 ? x_min : c == cols ? x_max : g.left(static_cast<int>(c));
+        edges[c] = std::clamp(x, x_min, x_max);
+    }
+    const std::vector<double> up = chain_at(upper, edges, true);
+    const std::vector<double> down = chain_at(lower, edges, false);
+    double scale = 1.0;
+    for (int id : inner) scale = std::max(scale, std::fabs(static_cast<double>(points_[id].y)));
+    const double margin = scale * 1e-9;
+    std::vector<double> below_top(cols);
+    std::vector<double> above_bottom(cols);
+    for (std::size_t c = 0; c < cols; ++c) {
+        below_top[c] = std::min(up[c], up[c + 1]) - margin;
+        above_bottom[c] = std::max(down[c], down[c + 1]) + margin;
+    }
+
+    // pass two, every point not clearly inside. the first hull's vertices
+    // are on its boundary so they come along
+    std::vector<std::vector<int>> keep(chunks);
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        std::vector<int>& out = keep[w];
+        for (std::size_t s = begin; s < end && !stop_requested(); s += kCheckEvery) {
+            const std::size_t e = std::min(end, s + kCheckEvery);
+            for (std::size_t i = s; i < e; ++i) {
+                const Point& p = points_[i];
+                const int c = g.column(p.x);
+                if (!(p.y < below_top[c] && p.y > above_bottom[c])) out.push_back(static_cast<int>(i));
+            }
+        }
+    });
+    checkpoint("filter", n, n);
+    cand_.clear();
+    for (const std::vector<int>& part : keep) cand_.insert(cand_.end(), part.begin(), part.end());
+    return hull_of_candidates();
+}
+
+std::vector<int> GridHullAlgorithm::run_full() {
+    return reduce_and_hull();
+}
+
+void GridHullAlgorithm::map_frame() {
+    fr_ = chain_.frame();
+    for (int& id : fr_.hull_indices) id = cand_[id];
+    if (fr_.active_a >= 0) fr_.active_a = cand_[fr_.active_a];
+    if (fr_.active_b >= 0) fr_.active_b = cand_[fr_.active_b];
+    if (fr_.active_c >= 0) fr_.active_c = cand_[fr_.active_c];
+}
+
+void GridHullAlgorithm::begin_stepping() {
+    // leaves chain_ holding the final candidates
+    reduce_and_hull();
+    chain_.begin_stepping();
+    map_frame();
+}
+
+bool GridHullAlgorithm::step() {
+    const bool more = chain_.step();
+    map_frame();
+    return more;
+}
@@ -0,0 +1,64 @@
+#ifndef ALGORITHMS_GRID_HULL_H
+#define ALGORITHMS_GRID_HULL_H
+
+#include "algorithms/andrew_algorithm.h"
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+#include <vector>
+
+// exact hull that throws most points away before sorting. points are
+// bucketed into columns of x, each thread keeping the lowest and highest
+// point per column, and Andrew runs on those and the two x extremes. a second
+// pass checks every point against that hull's chains at its column's edges,
+// where a concave upper chain is lowest and a convex lower chain highest, and
+// anything not clearly inside joins a final Andrew run. on uniform data both
+// passes are linear and each sort sees a few points per column at most.
+// skewed x gets quantile columns from a sample instead of equal widths
+class GridHullAlgorithm final : public ConvexHullAlgorithm {
+public:
+    GridHullAlgorithm() = default;
+
+    const char* name() const override { return "Grid"; }
+
+    void reset(const std::vector<core::Point>& pts) override;
+    void reset(std::vector<core::Point>&& pts) override;
+    std::vector<int> run_full() override;
+
+    // Andrew's frames over the final candidates
+    void begin_stepping() override;
+    bool step() override;
+    const core::HullFrame& frame() const override { return fr_; }
+    std::size_t frame_count() const override { return chain_.frame_count(); }
+
+private:
+    struct Grid {
+        int cols{1};
+        float x0{0.0f};
+        float inv_w{0.0f};             // equal widths, columns per unit of x
+        std::vector<float> bounds;     // left edge of each column, quantile grid only
+        std::vector<int> lut;          // equal width cells to the column of their left edge
+        float lut_scale{0.0f};
+
+        int column(float x) const;
+        float left(int c) const;
+    };
+
+    std::vector<core::Point> points_;
+    std::vector<int> cand_;            // ids of the points the last run kept
+
+    AndrewAlgorithm chain_;
+    core::HullFrame fr_{};
+
+    static constexpr std::size_t kPointsPerColumn = 256;
+    static constexpr std::size_t kSample = 1u << 16;
+
+    Grid make_grid() const;
+    // fills cand_ and returns the hull over them as ids into points_
+    std::vector<int> reduce_and_hull();
+    // Andrew over the points in cand_, ids into points_
+    std::vector<int> hull_of_candidates();
+    // chain_'s frame with its indices mapped back through cand_
+    void map_frame();
+};
+
+#endif
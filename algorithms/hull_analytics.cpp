@@ -0,0 +1,181 @@
+#include "algorithms/hull_analytics.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // hull vertices as doubles, and the input index of each
+    struct Poly {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<int> id;
+
+        Poly(const std::vector<core::Point>& pts, const std::vector<int>& hull) {
+            x.reserve(hull.size());
+            y.reserve(hull.size());
+            for (int i : hull) {
+                x.push_back(pts[i].x);
+                y.push_back(pts[i].y);
+            }
+            id = hull;
+        }
+
+        std::size_t size() const { return id.size(); }
+        double dist2(std::size_t a, std::size_t b) const {
+            const double dx = x[b] - x[a];
+            const double dy = y[b] - y[a];
+            return dx * dx + dy * dy;
+        }
+    };
+
+    // the rectangle over hull edge i with unit direction (ux, uy), spanning lo
+    // to hi along it, measured from vertex i, and height up from the edge
+    HullRect edge_rect(const Poly& p, std::size_t i, double ux, double uy, double lo, double hi, double height) {
+        const double nx = -uy;
+        const double ny = ux;
+        HullRect r;
+        r.corners[0] = {p.x[i] + lo * ux, p.y[i] + lo * uy};
+        r.corners[1] = {p.x[i] + hi * ux, p.y[i] + hi * uy};
+        r.corners[2] = {r.corners[1].x + height * nx, r.corners[1].y + height * ny};
+        r.corners[3] = {r.corners[0].x + height * nx, r.corners[0].y + height * ny};
+        r.area = (hi - lo) * height;
+        r.perimeter = 2.0 * ((hi - lo) + height);
+        return r;
+    }
+
+    // one or two vertices, no edge to put a caliper on
+    HullMetrics degenerate(const Poly& p) {
+        HullMetrics m;
+        if (p.size() == 0) return m;
+        m.farthest_a = p.id[0];
+        m.farthest_b = p.id[p.size() - 1];
+        m.diameter = std::sqrt(p.dist2(0, p.size() - 1));
+        HullRect r;
+        r.corners = {RectCorner{p.x[0], p.y[0]}, RectCorner{p.x.back(), p.y.back()},
+                     RectCorner{p.x.back(), p.y.back()}, RectCorner{p.x[0], p.y[0]}};
+        r.perimeter = 2.0 * m.diameter;
+        m.min_area = r;
+        m.min_perimeter = r;
+        return m;
+    }
+}
+
+HullMetrics hull_metrics(const std::vector<core::Point>& pts, const std::vector<int>& hull) {
+    const Poly p(pts, hull);
+    const std::size_t h = p.size();
+    if (h < 3) return degenerate(p);
+
+    auto next = [h](std::size_t k) { return k + 1 == h ? 0 : k + 1; };
+    HullMetrics m;
+    m.width = std::numeric_limits<double>::infinity();
+    m.min_area.area = std::numeric_limits<double>::infinity();
+    m.min_perimeter.perimeter = std::numeric_limits<double>::infinity();
+    double best_d2 = -1.0;
+
+    // r farthest along the edge, t farthest from it, l farthest back. all
+    // three rise once and fall once going round, so each pointer only
+    // follows the maximum forward, less than two laps in total
+    std::size_t r = 1;
+    std::size_t t = 1;
+    std::size_t l = 1;
+    for (std::size_t i = 0; i < h; ++i) {
+        const std::size_t j = next(i);
+        const double ex = p.x[j] - p.x[i];
+        const double ey = p.y[j] - p.y[i];
+        const double len = std::sqrt(ex * ex + ey * ey);
+        if (len == 0.0) continue;
+        const double ux = ex / len;
+        const double uy = ey / len;
+        auto along = [&](std::size_t k) { return (p.x[k] - p.x[i]) * ux + (p.y[k] - p.y[i]) * uy; };
+        auto up = [&](std::size_t k) { return (p.y[k] - p.y[i]) * ux - (p.x[k] - p.x[i]) * uy; };
+
+        if (i == 0) r = j;
+        for (std::size_t guard = 0; guard < h && along(next(r)) > along(r); ++guard) r = next(r);
+        if (i == 0) t = r;
+        for (std::size_t guard = 0; guard < h && up(next(t)) > up(t); ++guard) t = next(t);
+        if (i == 0) l = t;
+        for (std::size_t guard = 0; guard < h && along(next(l)) < along(l); ++guard) l = next(l);
+
+        // both ends of the edge against its antipodal vertex, and the one
+        // after, which ties with it when the edge there is parallel
+        for (std::size_t a : {i, j}) {
+            for (std::size_t b : {t, next(t)}) {
+                const double d2 = p.dist2(a, b);
+                if (d2 > best_d2) {
+                    best_d2 = d2;
+                    m.farthest_a = p.id[a];
+                    m.farthest_b = p.id[b];
+                }
+            }
+        }
+
+        const double height = up(t);
+        if (height < m.width) m.width = height;
+        const double lo = along(l);
+        const double hi = along(r);
+        const double area = (hi - lo) * height;
+        const double perimeter = 2.0 * ((hi - lo) + height);
+        if (area < m.min_area.area) m.min_area = edge_rect(p, i, ux, uy, lo, hi, height);
+        if (perimeter < m.min_perimeter.perimeter) m.min_perimeter = edge_rect(p, i, ux, uy, lo, hi, height);
+    }
+    m.diameter = std::sqrt(best_d2);
+    return m;
+}
+
+std::vector<HullMetrics> hull_metrics(const std::vector<core::Point>& pts, const std::vector<std::vector<int>>& hulls) {
+    std::vector<HullMetrics> out(hulls.size());
+    core::parallel_chunks(hulls.size(), [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t k = begin; k < end; ++k) out[k] = hull_metrics(pts, hulls[k]);
+    }, 64);
+    return out;
+}
+
+HullMetrics hull_metrics_naive(const std::vector<core::Point>& pts, const std::vector<int>& hull) {
+    const Poly p(pts, hull);
+    const std::size_t h = p.size();
+    if (h < 3) return degenerate(p);
+
+    HullMetrics m;
+    double best_d2 = -1.0;
+    for (std::size_t a = 0; a < h; ++a) {
+        for (std::size_t b = a + 1; b < h; ++b) {
+            const double d2 = p.dist2(a, b);
+            if (d2 > best_d2) {
+                best_d2 = d2;
+                m.farthest_a = p.id[a];
+                m.farthest_b = p.id[b];
+            }
+        }
+    }
+    m.diameter = std::sqrt(best_d2);
+
+    m.width = std::numeric_limits<double>::infinity();
+    m.min_area.area = std::numeric_limits<double>::infinity();
+    m.min_perimeter.perimeter = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < h; ++i) {
+        const std::size_t j = i + 1 == h ? 0 : i + 1;
+        const double ex = p.x[j] - p.x[i];
+        const double ey = p.y[j] - p.y[i];
+        const double len = std::sqrt(ex * ex + ey * ey);
+        if (len == 0.0) continue;
+        const double ux = ex / len;
+        const double uy = ey / len;
+        double lo = 0.0;
+        double hi = 0.0;
+        double height = 0.0;
+        for (std::size_t k = 0; k < h; ++k) {
+            const double a = (p.x[k] - p.x[i]) * ux + (p.y[k] - p.y[i]) * uy;
+            const double u = (p.y[k] - p.y[i]) * ux - (p.x[k] - p.x[i]) * uy;
+            lo = std::min(lo, a);
+            hi = std::max(hi, a);
+            height = std::max(height, u);
+        }
+        if (height < m.width) m.width = height;
+        const double area = (hi - lo) * height;
+        const double perimeter = 2.0 * ((hi - lo) + height);
+        if (area < m.min_area.area) m.min_area = edge_rect(p, i, ux, uy, lo, hi, height);
+        if (perimeter < m.min_perimeter.perimeter) m.min_perimeter = edge_rect(p, i, ux, uy, lo, hi, height);
+    }
+    return m;
+}
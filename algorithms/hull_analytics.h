@@ -0,0 +1,44 @@
+#ifndef ALGORITHMS_HULL_ANALYTICS_H
+#define ALGORITHMS_HULL_ANALYTICS_H
+
+#include <array>
+#include <vector>
+#include "core/types.h"
+
+struct RectCorner {
+    double x{0.0};
+    double y{0.0};
+};
+
+// a bounding rectangle with one side flush with a hull edge, corners CCW
+struct HullRect {
+    std::array<RectCorner, 4> corners{};
+    double area{0.0};
+    double perimeter{0.0};
+};
+
+struct HullMetrics {
+    double diameter{0.0};
+    int farthest_a{-1};     // the farthest pair, indices into the input
+    int farthest_b{-1};
+    double width{0.0};      // smallest distance between two parallel supporting lines
+    HullRect min_area;
+    HullRect min_perimeter;
+};
+
+// diameter, farthest pair, minimum width and the minimum area and minimum
+// perimeter bounding rectangles of a hull from run_full, in one rotating
+// calipers pass, O(h). every edge gets the vertex farthest along it, the
+// farthest from it and the farthest back, each pointer only moving forward.
+// both rectangles have a side on some hull edge, and the farthest pair is
+// among the vertices antipodal to an edge's ends
+HullMetrics hull_metrics(const std::vector<core::Point>& pts, const std::vector<int>& hull);
+
+// many hulls over the same points, split over threads
+std::vector<HullMetrics> hull_metrics(const std::vector<core::Point>& pts, const std::vector<std::vector<int>>& hulls);
+
+// the same metrics by scanning every vertex for every edge and every pair,
+// O(h^2), as a reference
+HullMetrics hull_metrics_naive(const std::vector<core::Point>& pts, const std::vector<int>& hull);
+
+#endif
@@ -0,0 +1,188 @@
+#include "algorithms/hull_merge.h"
+#include "core/geometry.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <utility>
+
+using core::Point;
+
+namespace {
+    bool less_xy(const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    // one chain of a mergeable hull as a sequence sorted by x then y. the
+    // lower chain is vertices 0 to right as stored, the upper one is read
+    // backwards from vertex 0 round to right
+    struct Chain {
+        const Point* v;
+        std::size_t h;
+        std::size_t len;
+        bool upper;
+
+        const Point& operator[](std::size_t i) const { return upper ? v[i == 0 ? 0 : h - i] : v[i]; }
+    };
+
+    Chain lower_chain(const MergeableHull& m) {
+        return {m.vertices.data(), m.vertices.size(), m.right + 1, false};
+    }
+
+    Chain upper_chain(const MergeableHull& m) {
+        const std::size_t h = m.vertices.size();
+        return {m.vertices.data(), h, m.right == 0 ? 1 : h - m.right + 1, true};
+    }
+
+    // first position in [0, len - 1) where pred holds, len - 1 when it never
+    // does. pred must turn true once and stay true
+    template <class Pred>
+    std::size_t first_true(std::size_t len, Pred pred) {
+        std::size_t lo = 0;
+        std::size_t hi = len - 1;
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (pred(mid)) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // the bridge between chain a and chain b strictly right of it, as a
+    // position on each. sign 1 for upper chains, -1 for lower ones, which
+    // mirrors a convex lower chain into a concave upper one. the tangent from
+    // a point goes to the farthest of collinear vertices and the search over a
+    // stops at the first of them, so neither end leaves a vertex on the bridge
+    std::pair<std::size_t, std::size_t> bridge(const Chain& a, const Chain& b, double sign) {
+        auto tangent = [&](const Point& p) {
+            return first_true(b.len, [&](std::size_t j) { return sign * core::orient(p, b[j], b[j + 1]) < 0.0; });
+        };
+        const std::size_t i = first_true(a.len, [&](std::size_t i) {
+            return sign * core::orient(a[i], b[tangent(a[i])], a[i + 1]) <= 0.0;
+        });
+        return {i, tangent(a[i])};
+    }
+
+    // b strictly right of a in x, the caller checks
+    MergeableHull merge_apart(const MergeableHull& a, const MergeableHull& b) {
+        const Chain la = lower_chain(a);
+        const Chain ua = upper_chain(a);
+        const Chain lb = lower_chain(b);
+        const Chain ub = upper_chain(b);
+        const auto [il, jl] = bridge(la, lb, -1.0);
+        const auto [iu, ju] = bridge(ua, ub, 1.0);
+
+        MergeableHull out;
+        out.vertices.reserve(il + 1 + (lb.len - jl) + (ub.len - ju) + iu);
+        for (std::size_t i = 0; i <= il; ++i) out.vertices.push_back(la[i]);
+        for (std::size_t j = jl; j < lb.len; ++j) out.vertices.push_back(lb[j]);
+        out.right = out.vertices.size() - 1;
+        // back along the upper chains. b's last upper vertex is its right one,
+        // already placed, and its first is vertex 0, placed when the lower
+        // bridge ends there too. the same holds for a's right vertex and the
+        // lower bridge, and a's vertex 0 starts the result
+        const std::size_t b_stop = (ju == 0 && jl == 0) ? 1 : ju;
+        for (std::size_t j = ub.len - 1; j-- > b_stop;) out.vertices.push_back(ub[j]);
+        const std::size_t a_end = (iu == ua.len - 1 && il == la.len - 1) ? iu : iu + 1;
+        for (std::size_t i = a_end; i-- > 1;) out.vertices.push_back(ua[i]);
+        return out;
+    }
+
+    // the vertices of a hull sorted by x then y, its two chains merged. the
+    // two ends appear twice
+    std::vector<Point> sorted_vertices(const MergeableHull& m) {
+        const Chain lo = lower_chain(m);
+        const Chain up = upper_chain(m);
+        std::vector<Point> out(lo.len + up.len);
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t k = 0;
+        while (i < lo.len && j < up.len) out[k++] = less_xy(up[j], lo[i]) ? up[j++] : lo[i++];
+        while (i < lo.len) out[k++] = lo[i++];
+        while (j < up.len) out[k++] = up[j++];
+        return out;
+    }
+
+    // monotone chain over points sorted by x then y, lower chain then upper,
+    // the last push closing on the first point
+    MergeableHull hull_of_sorted(std::vector<Point> sorted) {
+        sorted.erase(std::unique(sorted.begin(), sorted.end(), core::same_position), sorted.end());
+        MergeableHull out;
+        const std::size_t m = sorted.size();
+        if (m < 2) {
+            out.vertices = std::move(sorted);
+            return out;
+        }
+        std::vector<Point>& h = out.vertices;
+        h.resize(2 * m);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+            while (k >= 2 && core::orient(h[k - 2], h[k - 1], sorted[i]) <= 0.0) --k;
+            h[k++] = sorted[i];
+        }
+        out.right = k - 1;
+        const std::size_t lower = k + 1;
+        for (std::size_t i = m - 1; i-- > 0;) {
+            while (k >= lower && core::orient(h[k - 2], h[k - 1], sorted[i]) <= 0.0) --k;
+            h[k++] = sorted[i];
+        }
+        h.resize(k - 1);
+        return out;
+    }
+}
+
+MergeableHull make_mergeable(std::vector<Point> hull) {
+    if (hull.empty()) return {};
+
+    // a CCW hull read from its lowest x, lowest y vertex is sorted up to the
+    // highest and back down after it. anything else is sorted in full
+    const auto first = std::min_element(hull.begin(), hull.end(), less_xy);
+    std::rotate(hull.begin(), first, hull.end());
+    MergeableHull raw;
+    raw.right = static_cast<std::size_t>(std::max_element(hull.begin(), hull.end(), less_xy) - hull.begin());
+    const bool chains_sorted =
+        std::is_sorted(hull.begin(), hull.begin() + static_cast<std::ptrdiff_t>(raw.right) + 1, less_xy) &&
+        std::is_sorted(hull.rbegin(), hull.rend() - static_cast<std::ptrdiff_t>(raw.right), less_xy);
+    if (!chains_sorted) {
+        std::sort(hull.begin(), hull.end(), less_xy);
+        return hull_of_sorted(std::move(hull));
+    }
+    // the chain pass drops collinear vertices and repeated positions, and
+    // any vertex rounding left slightly reflex
+    raw.vertices = std::move(hull);
+    return hull_of_sorted(sorted_vertices(raw));
+}
+
+MergeableHull make_mergeable(const std::vector<Point>& pts, const std::vector<int>& hull) {
+    std::vector<Point> v;
+    v.reserve(hull.size());
+    for (int id : hull) v.push_back(pts[id]);
+    return make_mergeable(std::move(v));
+}
+
+MergeableHull merge_hulls_linear(const MergeableHull& a, const MergeableHull& b) {
+    const std::vector<Point> sa = sorted_vertices(a);
+    const std::vector<Point> sb = sorted_vertices(b);
+    std::vector<Point> sorted(sa.size() + sb.size());
+    std::merge(sa.begin(), sa.end(), sb.begin(), sb.end(), sorted.begin(), less_xy);
+    return hull_of_sorted(std::move(sorted));
+}
+
+MergeableHull merge_hulls(const MergeableHull& a, const MergeableHull& b) {
+    if (a.empty()) return b;
+    if (b.empty()) return a;
+    if (a.vertices[a.right].x < b.vertices[0].x) return merge_apart(a, b);
+    if (b.vertices[b.right].x < a.vertices[0].x) return merge_apart(b, a);
+    return merge_hulls_linear(a, b);
+}
+
+MergeableHull merge_hulls(std::vector<MergeableHull> hulls) {
+    while (hulls.size() > 1) {
+        const std::size_t pairs = hulls.size() / 2;
+        std::vector<MergeableHull> next(pairs + hulls.size() % 2);
+        core::parallel_chunks(pairs, [&](std::size_t begin, std::size_t end, unsigned) {
+            for (std::size_t p = begin; p < end; ++p) next[p] = merge_hulls(hulls[2 * p], hulls[2 * p + 1]);
+        }, 1);
+        if (hulls.size() % 2) next.back() = std::move(hulls.back());
+        hulls.swap(next);
+    }
+    return hulls.empty() ? MergeableHull{} : std::move(hulls.front());
+}
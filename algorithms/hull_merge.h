@@ -0,0 +1,40 @@
+#ifndef ALGORITHMS_HULL_MERGE_H
+#define ALGORITHMS_HULL_MERGE_H
+
+#include <cstddef>
+#include <vector>
+#include "core/types.h"
+
+// a convex hull kept ready for merging, its vertices CCW from the lowest x,
+// lowest y one, so the lower chain runs up to right and the upper chain back
+// from there, both sorted. vertices are copies of the input points and keep
+// their ids, so any merge result is in the id space of the original points
+struct MergeableHull {
+    std::vector<core::Point> vertices;
+    std::size_t right{0};   // the highest x, highest y vertex
+
+    bool empty() const { return vertices.empty(); }
+};
+
+// from a CCW hull in any rotation, O(h). collinear and repeated vertices are
+// dropped. any other list of points is sorted first and gives its hull
+MergeableHull make_mergeable(std::vector<core::Point> hull);
+// from run_full's result, indices into pts
+MergeableHull make_mergeable(const std::vector<core::Point>& pts, const std::vector<int>& hull);
+
+// hull of the union of two hulls. hulls apart in x are joined by their upper
+// and lower bridges, each found by a binary search over one hull's chain with
+// a binary search for the tangent on the other inside, O(log h1 log h2) tests
+// plus copying the result. anything else merges the four sorted chains and
+// runs one monotone chain pass, O(h1 + h2)
+MergeableHull merge_hulls(const MergeableHull& a, const MergeableHull& b);
+
+// always the linear merge, also for hulls apart in x
+MergeableHull merge_hulls_linear(const MergeableHull& a, const MergeableHull& b);
+
+// hull of the union of any number of hulls, merged pairwise in rounds, the
+// pairs of a round in parallel. neighbours in the list are paired, so tiles in
+// row order mostly meet hulls apart in x
+MergeableHull merge_hulls(std::vector<MergeableHull> hulls);
+
+#endif
@@ -0,0 +1,444 @@
+#ifndef ALGORITHMS_HULL_PIPELINE_H
+#define ALGORITHMS_HULL_PIPELINE_H
+
+#include "algorithms/convex_hull_algorithm.h"
+#include "algorithms/hull_verifier.h"
+#include "core/checks.h"
+#include "core/geometry.h"
+#include "core/parallel.h"
+#include "core/types.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// a hull built from three stages picked at compile time, prefilter, sort and
+// chain, so the per point work of each stage inlines into the loop that
+// drives it. everything is in this header for that reason. a stage is any
+// type with the members below
+//
+//   prefilter  name, filters, prepare(pts, checks), keep(p)
+//   sorter     name, sort(pts, ids, checks) ordering ids by x then y
+//   chain      name, build<Record>(pts, sorted ids, frames, checks) returning CCW ids
+namespace pipeline {
+    // keeps every point, the pipeline skips the filter pass entirely
+    struct KeepAll {
+        static constexpr const char* name = "all";
+        static constexpr bool filters = false;
+
+        void prepare(const std::vector<core::Point>&, const core::Checks& = {}) {}
+        bool keep(const core::Point&) const { return true; }
+    };
+
+    // drops points strictly inside the polygon of the extreme points in the
+    // eight directions of x, y, x + y and x - y. its vertices are input
+    // points, so nothing dropped can be on the hull. on uniform data that is
+    // most points, before anything is sorted
+    struct AklToussaint {
+        static constexpr const char* name = "Akl-Toussaint";
+        static constexpr bool filters = true;
+
+        std::array<core::Point, 8> poly{};
+        int count{0};   // distinct vertices, below 3 keeps everything
+
+        void prepare(const std::vector<core::Point>& pts, const core::Checks& checks = {}) {
+            count = 0;
+            if (pts.empty()) return;
+            // directions CCW from straight down. ties go to the point last in
+            // CCW order along the supporting line, which keeps the polygon
+            // convex when several points share an extreme
+            static constexpr int dir[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+            auto better = [](int k, const core::Point& p, const core::Point& q) {
+                const double dx = dir[k][0];
+                const double dy = dir[k][1];
+                const double kp = dx * p.x + dy * p.y;
+                const double kq = dx * q.x + dy * q.y;
+                return kp > kq || (kp == kq && dx * p.y - dy * p.x > dx * q.y - dy * q.x);
+            };
+            const std::size_t chunks = core::chunk_count(pts.size());
+            std::vector<std::array<int, 8>> best(chunks);
+            core::parallel_chunks(pts.size(), [&](std::size_t begin, std::size_t end, unsigned w) {
+                std::array<int, 8> b;
+                b.fill(static_cast<int>(begin));
+                for (std::size_t slice = begin + 1; slice < end; slice += core::kCheckEvery) {
+                    if (checks.stop_requested()) break;
+                    const std::size_t slice_end = std::min(end, slice + core::kCheckEvery);
+                    for (std::size_t i = slice; i < slice_end; ++i) {
+                        for (int k = 0; k < 8; ++k) {
+                            if (better(k, pts[i], pts[b[k]])) b[k] = static_cast<int>(i);
+                        }
+                    }
+                }
+                best[w] = b;
+            });
+            checks.checkpoint("extremes", pts.size(), pts.size());
+            std::array<int, 8> b = best[0];
+            for (std::size_t w = 1; w < chunks; ++w) {
+                for (int k = 0; k < 8; ++k) {
+                    if (better(k, pts[best[w][k]], pts[b[k]])) b[k] = best[w][k];
+                }
+            }
+            for (int k = 0; k < 8; ++k) {
+                const core::Point& p = pts[b[k]];
+                if (count > 0 && core::same_position(p, poly[count - 1])) continue;
+                if (count > 0 && core::same_position(p, poly[0])) continue;
+                poly[count++] = p;
+            }
+            if (count < 3) count = 0;
+        }
+
+        bool keep(const core::Point& p) const {
+            for (int i = 0; i < count; ++i) {
+                const core::Point& a = poly[i];
+                const core::Point& b = poly[i + 1 < count ? i + 1 : 0];
+                if (core::orient(a, b, p) <= 0.0) return true;
+            }
+            return count == 0;
+        }
+    };
+
+    struct LessXY {
+        bool operator()(const core::Point& a, const core::Point& b) const {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        }
+    };
+
+    // std::sort of the ids with the comparison inlined
+    template <class Less = LessXY>
+    struct ComparisonSort {
+        static constexpr const char* name = "std::sort";
+
+        Less less{};
+
+        // a single std::sort call, only looked at before and after
+        void sort(const std::vector<core::Point>& pts, std::vector<int>& ids, const core::Checks& checks = {}) const {
+            checks.checkpoint("sort", 0, ids.size());
+            std::sort(ids.begin(), ids.end(), [&](int a, int b) { return less(pts[a], pts[b]); });
+        }
+    };
+
+    // least significant digit radix sort on x and y as one 64 bit key, four
+    // passes of 16 bits, each skipped when all keys share that digit
+    struct RadixSort {
+        static constexpr const char* name = "radix";
+
+        // a float's bits reordered so unsigned comparison follows its value.
+        // -0 compares equal to +0, so it takes the same bits
+        static std::uint32_t ordered(float f) {
+            const std::uint32_t u = std::bit_cast<std::uint32_t>(f == 0.0f ? 0.0f : f);
+            return (u & 0x80000000u) ? ~u : u | 0x80000000u;
+        }
+
+        void sort(const std::vector<core::Point>& pts, std::vector<int>& ids, const core::Checks& checks = {}) const {
+            const std::size_t n = ids.size();
+            if (n < 2) return;
+            // the buffers grow a slice at a time, zeroing hundreds of
+            // megabytes in one go would hold a stop up as long as a pass
+            std::vector<std::uint64_t> keys;
+            std::vector<std::uint64_t> keys_tmp;
+            std::vector<int> ids_tmp;
+            keys.reserve(n);
+            keys_tmp.reserve(n);
+            ids_tmp.reserve(n);
+            core::sliced(checks, "sort", n, [&](std::size_t begin, std::size_t end) {
+                keys_tmp.resize(end);
+                ids_tmp.resize(end);
+                for (std::size_t i = begin; i < end; ++i) {
+                    const core::Point& p = pts[ids[i]];
+                    keys.push_back(static_cast<std::uint64_t>(ordered(p.x)) << 32 | ordered(p.y));
+                }
+            });
+            std::vector<std::size_t> count(1u << 16);
+            for (int shift = 0; shift < 64; shift += 16) {
+                std::fill(count.begin(), count.end(), 0);
+                core::sliced(checks, "sort", n, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) ++count[(keys[i] >> shift) & 0xffff];
+                });
+                if (count[(keys[0] >> shift) & 0xffff] == n) continue;
+                std::size_t sum = 0;
+                for (std::size_t& c : count) {
+                    const std::size_t here = c;
+                    c = sum;
+                    sum += here;
+                }
+                core::sliced(checks, "sort", n, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const std::size_t at = count[(keys[i] >> shift) & 0xffff]++;
+                        keys_tmp[at] = keys[i];
+                        ids_tmp[at] = ids[i];
+                    }
+                });
+                keys.swap(keys_tmp);
+                ids.swap(ids_tmp);
+            }
+        }
+    };
+
+    struct Orient {
+        double operator()(const core::Point& a, const core::Point& b, const core::Point& c) const {
+            return core::orient(a, b, c);
+        }
+    };
+
+    // Andrew's monotone chain over ids sorted by x then y. collinear points
+    // and repeated positions are dropped. Record adds a frame per push and pop
+    template <class Turn = Orient>
+    struct MonotoneChain {
+        static constexpr const char* name = "monotone chain";
+
+        Turn turn{};
+
+        template <bool Record>
+        std::vector<int> build(const std::vector<core::Point>& pts, const std::vector<int>& sorted,
+                               std::vector<core::HullFrame>* frames, const core::Checks& checks = {}) const {
+            std::vector<int> uniq;
+            uniq.reserve(sorted.size());
+            core::sliced(checks, "chain", sorted.size(), [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const int id = sorted[i];
+                    if (uniq.empty() || !core::same_position(pts[id], pts[uniq.back()])) uniq.push_back(id);
+                }
+            });
+            const std::size_t m = uniq.size();
+            if (m < 2) {
+                if constexpr (Record) record(*frames, "Done", -1, -1, -1, uniq, m);
+                return uniq;
+            }
+
+            // grown by the pushes rather than zeroed up front, which would be
+            // one long stretch without a check
+            std::vector<int> h;
+            h.reserve(2 * m);
+            std::size_t k = 0;
+            auto push = [&](int id, std::size_t floor) {
+                while (k >= floor && turn(pts[h[k - 2]], pts[h[k - 1]], pts[id]) <= 0.0) {
+                    if constexpr (Record) record(*frames, "Remove from chain", h[k - 2], h[k - 1], id, h, k);
+                    --k;
+                }
+                if (k == h.size()) h.push_back(id);
+                else h[k] = id;
+                ++k;
+                if constexpr (Record) record(*frames, "Add to chain", k >= 2 ? h[k - 2] : -1, id, -1, h, k);
+            };
+            // lower chain left to right, then the upper one back, the last
+            // push closing on the first point. pops are paid for by pushes,
+            // so a slice of pushes bounds the work between checks
+            core::sliced(checks, "chain", m, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) push(uniq[i], 2);
+            });
+            const std::size_t lower = k + 1;
+            core::sliced(checks, "chain", m - 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t j = begin; j < end; ++j) push(uniq[m - 2 - j], lower);
+            });
+            h.resize(k - 1);
+            if constexpr (Record) record(*frames, "Done", -1, -1, -1, h, h.size());
+            return h;
+        }
+
+    private:
+        static void record(std::vector<core::HullFrame>& frames, const char* label, int a, int b, int c,
+                           const std::vector<int>& h, std::size_t k) {
+            core::HullFrame f{};
+            f.label = label;
+            f.active_a = a;
+            f.active_b = b;
+            f.active_c = c;
+            f.hull_indices.assign(h.begin(), h.begin() + static_cast<std::ptrdiff_t>(k));
+            frames.push_back(std::move(f));
+        }
+    };
+
+    // a prefilter with its per point test behind a std::function, and the
+    // type erased comparison and turn for the other two stages. they run the
+    // same code with an indirect call per point, comparison and turn, to
+    // measure what inlining buys
+    template <class P>
+    struct ErasedPrefilter {
+        static constexpr const char* name = P::name;
+        static constexpr bool filters = P::filters;
+
+        P inner{};
+        std::function<bool(const core::Point&)> test;
+
+        void prepare(const std::vector<core::Point>& pts, const core::Checks& checks = {}) {
+            inner.prepare(pts, checks);
+            test = [this](const core::Point& p) { return inner.keep(p); };
+        }
+        bool keep(const core::Point& p) const { return test(p); }
+    };
+    using ErasedLess = std::function<bool(const core::Point&, const core::Point&)>;
+    using ErasedTurn = std::function<double(const core::Point&, const core::Point&, const core::Point&)>;
+
+    struct Config {
+        bool parallel{true};   // filter pass split over threads
+        bool verify{false};    // check every result, throws on a bad hull
+    };
+}
+
+template <class Prefilter, class Sorter, class ChainBuilder, pipeline::Config Config = pipeline::Config{}>
+class HullPipeline {
+public:
+    HullPipeline() = default;
+    HullPipeline(Prefilter pre, Sorter sorter, ChainBuilder chain)
+        : pre_(std::move(pre)), sorter_(std::move(sorter)), chain_(std::move(chain)) {}
+
+    static std::string name() {
+        return std::string(Prefilter::name) + " + " + Sorter::name + " + " + ChainBuilder::name;
+    }
+
+    std::vector<int> run(const std::vector<core::Point>& pts) {
+        return run_stages<false>(pts, nullptr, {});
+    }
+
+    // the same run with every stage looking at checks between slices
+    std::vector<int> run(const std::vector<core::Point>& pts, const core::Checks& checks) {
+        return run_stages<false>(pts, nullptr, checks);
+    }
+
+    // the same run with the chain's frames appended to frames, after one
+    // showing what the prefilter kept
+    std::vector<int> run(const std::vector<core::Point>& pts, std::vector<core::HullFrame>& frames) {
+        return run_stages<true>(pts, &frames, {});
+    }
+
+    // points left after the prefilter in the last run
+    std::size_t kept() const { return ids_.size(); }
+
+private:
+    Prefilter pre_{};
+    Sorter sorter_{};
+    ChainBuilder chain_{};
+    std::vector<int> ids_;
+
+    template <bool Record>
+    std::vector<int> run_stages(const std::vector<core::Point>& pts, std::vector<core::HullFrame>* frames,
+                                const core::Checks& checks) {
+        filter(pts, checks);
+        if constexpr (Record) {
+            core::HullFrame f{};
+            f.label = "Prefilter kept " + std::to_string(ids_.size()) + " of " + std::to_string(pts.size());
+            frames->push_back(std::move(f));
+        }
+        sorter_.sort(pts, ids_, checks);
+        std::vector<int> hull = chain_.template build<Record>(pts, ids_, frames, checks);
+        if constexpr (Config.verify) {
+            const HullVerifyResult res = HullVerifier().verify(pts, hull);
+            if (!res.ok) throw std::runtime_error("hull pipeline produced a bad hull: " + res.error);
+        }
+        return hull;
+    }
+
+    void filter(const std::vector<core::Point>& pts, const core::Checks& checks) {
+        const std::size_t n = pts.size();
+        ids_.reserve(n);
+        core::sliced(checks, "filter", n, [&](std::size_t, std::size_t end) { ids_.resize(end); });
+        if constexpr (!Prefilter::filters) {
+            core::sliced(checks, "filter", n, [&](std::size_t begin, std::size_t end) {
+                std::iota(ids_.begin() + static_cast<std::ptrdiff_t>(begin), ids_.begin() + static_cast<std::ptrdiff_t>(end),
+                          static_cast<int>(begin));
+            });
+        } else {
+            pre_.prepare(pts, checks);
+            if constexpr (Config.parallel) {
+                // each chunk compacts its own range in place, then the
+                // survivors are moved down next to each other
+                const std::size_t chunks = core::chunk_count(n);
+                std::vector<std::size_t> begins(chunks);
+                std::vector<std::size_t> sizes(chunks);
+                core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+                    std::size_t out = begin;
+                    for (std::size_t slice = begin; slice < end; slice += core::kCheckEvery) {
+                        if (checks.stop_requested()) break;
+                        const std::size_t slice_end = std::min(end, slice + core::kCheckEvery);
+                        for (std::size_t i = slice; i < slice_end; ++i) {
+                            ids_[out] = static_cast<int>(i);
+                            out += pre_.keep(pts[i]) ? 1 : 0;
+                        }
+                    }
+                    begins[w] = begin;
+                    sizes[w] = out - begin;
+                });
+                checks.checkpoint("filter", n, n);
+                std::size_t out = 0;
+                for (std::size_t w = 0; w < chunks; ++w) {
+                    std::copy(ids_.begin() + static_cast<std::ptrdiff_t>(begins[w]),
+                              ids_.begin() + static_cast<std::ptrdiff_t>(begins[w] + sizes[w]),
+                              ids_.begin() + static_cast<std::ptrdiff_t>(out));
+                    out += sizes[w];
+                }
+                ids_.resize(out);
+            } else {
+                std::size_t out = 0;
+                core::sliced(checks, "filter", n, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        ids_[out] = static_cast<int>(i);
+                        out += pre_.keep(pts[i]) ? 1 : 0;
+                    }
+                });
+                ids_.resize(out);
+            }
+        }
+    }
+};
+
+// any pipeline as a ConvexHullAlgorithm, for the visualizer and the
+// benchmarks. the virtual call happens once per run, not per point
+template <class Pipeline>
+class PipelineAlgorithm final : public ConvexHullAlgorithm {
+public:
+    PipelineAlgorithm() = default;
+
+    const char* name() const override {
+        static const std::string n = Pipeline::name();
+        return n.c_str();
+    }
+
+    void reset(const std::vector<core::Point>& pts) override { reset(std::vector<core::Point>(pts)); }
+
+    void reset(std::vector<core::Point>&& pts) override {
+        points_ = std::move(pts);
+        frames_.clear();
+        frame_pos_ = 0;
+        fr_ = core::HullFrame{};
+    }
+
+    // a plain run keeps the stages free of checks, a cancellable one looks
+    // at the token between slices of every stage
+    std::vector<int> run_full() override {
+        if (!cancellable()) return pipeline_.run(points_);
+        return pipeline_.run(points_, checks());
+    }
+
+    void begin_stepping() override {
+        frames_.clear();
+        pipeline_.run(points_, frames_);
+        frame_pos_ = 0;
+        fr_ = frames_.front();
+    }
+
+    bool step() override {
+        if (frame_pos_ + 1 >= frames_.size()) return false;
+        ++frame_pos_;
+        fr_ = frames_[frame_pos_];
+        return frame_pos_ + 1 < frames_.size();
+    }
+
+    const core::HullFrame& frame() const override { return fr_; }
+    std::size_t frame_count() const override { return frames_.size(); }
+
+private:
+    Pipeline pipeline_;
+    std::vector<core::Point> points_;
+
+    // precomputed frames
+    std::vector<core::HullFrame> frames_;
+    std::size_t frame_pos_{0};
+    core::HullFrame fr_{};
+};
+
+#endif
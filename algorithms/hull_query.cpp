@@ -0,0 +1,158 @@
+#include "algorithms/hull_query.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using core::Point;
+
+namespace {
+    // queries searched side by side. every one of them takes the same number
+    // of halving rounds, so the inner loop has no data dependent branch and
+    // the loads of a block overlap
+    constexpr std::size_t kBlock = 16;
+
+    // queries per thread before splitting is worth it
+    constexpr std::size_t kMinChunk = 1u << 14;
+}
+
+HullQuery::HullQuery(const std::vector<Point>& pts, const std::vector<int>& hull) {
+    xs_.reserve(hull.size());
+    ys_.reserve(hull.size());
+    ids_.reserve(hull.size());
+    for (int id : hull) {
+        if (id < 0 || static_cast<std::size_t>(id) >= pts.size()) {
+            throw std::runtime_error("hull index " + std::to_string(id) + " out of range");
+        }
+        xs_.push_back(pts[id].x);
+        ys_.push_back(pts[id].y);
+        ids_.push_back(id);
+    }
+}
+
+double HullQuery::orient(int a, int b, double px, double py) const {
+    return (xs_[b] - xs_[a]) * (py - ys_[a]) - (ys_[b] - ys_[a]) * (px - xs_[a]);
+}
+
+double HullQuery::orient(double px, double py, int a, int b) const {
+    return (xs_[a] - px) * (ys_[b] - py) - (ys_[a] - py) * (xs_[b] - px);
+}
+
+template <class Less>
+int HullQuery::cyclic_max(Less less) const {
+    const int h = static_cast<int>(ids_.size());
+    if (h == 1) return 0;
+
+    // positions before the maximum are the ones on the rise towards it. going
+    // around from 0 that is a prefix, so binary search for where it ends. if
+    // the sequence rises at 0, a rising position with a value below the one at
+    // 0 belongs to the climb back after the minimum. if it falls at 0, a
+    // falling position with a value above the one at 0 comes after the maximum
+    auto rises = [&](int c) { return less(c, c + 1 == h ? 0 : c + 1); };
+    const bool rises0 = rises(0);
+    auto before_max = [&](int c) {
+        return rises0 ? rises(c) && !less(c, 0) : rises(c) || !less(0, c);
+    };
+
+    int lo = 0;
+    int hi = h;
+    while (hi - lo > 1) {
+        const int mid = lo + (hi - lo) / 2;
+        if (before_max(mid)) lo = mid;
+        else hi = mid;
+    }
+    return hi == h ? 0 : hi;
+}
+
+int HullQuery::wedge(double px, double py) const {
+    int base = 1;
+    for (int span = static_cast<int>(ids_.size()) - 2; span > 1;) {
+        const int half = span / 2;
+        base = orient(0, base + half, px, py) >= 0.0 ? base + half : base;
+        span -= half;
+    }
+    return base;
+}
+
+bool HullQuery::contains_at(double px, double py, int k) const {
+    const int h = static_cast<int>(ids_.size());
+    return orient(0, 1, px, py) >= 0.0 && orient(0, h - 1, px, py) <= 0.0 && orient(k, k + 1, px, py) >= 0.0;
+}
+
+bool HullQuery::contains(const Point& p) const {
+    const int h = static_cast<int>(ids_.size());
+    const double px = p.x;
+    const double py = p.y;
+    if (h == 0) return false;
+    if (h == 1) return px == xs_[0] && py == ys_[0];
+    if (h == 2) {
+        return orient(0, 1, px, py) == 0.0 &&
+               std::min(xs_[0], xs_[1]) <= px && px <= std::max(xs_[0], xs_[1]) &&
+               std::min(ys_[0], ys_[1]) <= py && py <= std::max(ys_[0], ys_[1]);
+    }
+    return contains_at(px, py, wedge(px, py));
+}
+
+HullTangents HullQuery::tangents(const Point& p) const {
+    if (ids_.empty() || contains(p)) return {};
+    const double px = p.x;
+    const double py = p.y;
+    // from outside, the hull spans less than half a turn, so orientation
+    // orders its vertices by angle around p
+    const int left = cyclic_max([&](int i, int j) { return orient(px, py, i, j) > 0.0; });
+    const int right = cyclic_max([&](int i, int j) { return orient(px, py, i, j) < 0.0; });
+    return {ids_[left], ids_[right]};
+}
+
+int HullQuery::extreme(double dx, double dy) const {
+    if (ids_.empty()) return -1;
+    const int best = cyclic_max([&](int i, int j) { return dx * xs_[i] + dy * ys_[i] < dx * xs_[j] + dy * ys_[j]; });
+    return ids_[best];
+}
+
+std::vector<unsigned char> HullQuery::contains(const std::vector<Point>& queries) const {
+    std::vector<unsigned char> out(queries.size(), 0);
+    const int h = static_cast<int>(ids_.size());
+    core::parallel_chunks(queries.size(), [&](std::size_t begin, std::size_t end, unsigned) {
+        if (h < 3) {
+            for (std::size_t i = begin; i < end; ++i) out[i] = contains(queries[i]);
+            return;
+        }
+        std::array<double, kBlock> px{};
+        std::array<double, kBlock> py{};
+        std::array<int, kBlock> base{};
+        for (std::size_t b = begin; b < end; b += kBlock) {
+            const std::size_t len = std::min(kBlock, end - b);
+            for (std::size_t j = 0; j < len; ++j) {
+                px[j] = queries[b + j].x;
+                py[j] = queries[b + j].y;
+                base[j] = 1;
+            }
+            for (int span = h - 2; span > 1;) {
+                const int half = span / 2;
+                for (std::size_t j = 0; j < len; ++j) {
+                    base[j] = orient(0, base[j] + half, px[j], py[j]) >= 0.0 ? base[j] + half : base[j];
+                }
+                span -= half;
+            }
+            for (std::size_t j = 0; j < len; ++j) out[b + j] = contains_at(px[j], py[j], base[j]);
+        }
+    }, kMinChunk);
+    return out;
+}
+
+std::vector<HullTangents> HullQuery::tangents(const std::vector<Point>& queries) const {
+    std::vector<HullTangents> out(queries.size());
+    core::parallel_chunks(queries.size(), [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t i = begin; i < end; ++i) out[i] = tangents(queries[i]);
+    }, kMinChunk);
+    return out;
+}
+
+std::vector<int> HullQuery::extreme(const std::vector<Point>& directions) const {
+    std::vector<int> out(directions.size(), -1);
+    core::parallel_chunks(directions.size(), [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t i = begin; i < end; ++i) out[i] = extreme(directions[i].x, directions[i].y);
+    }, kMinChunk);
+    return out;
+}
@@ -0,0 +1,61 @@
+#ifndef ALGORITHMS_HULL_QUERY_H
+#define ALGORITHMS_HULL_QUERY_H
+
+#include <vector>
+#include "core/types.h"
+
+// the two hull vertices seen from an outside point at the ends of the hull's
+// silhouette, as indices into the input. every hull vertex is on or right of
+// the ray from the point to left, and on or left of the ray to right
+struct HullTangents {
+    int left{-1};
+    int right{-1};
+};
+
+// O(log h) queries against a hull from run_full: point in hull, tangents
+// from an outside point, and the vertex extreme in a direction. the hull's
+// vertices are copied once into flat double arrays, the batched calls split
+// the queries over threads and run blocks of them through the search in
+// lockstep
+class HullQuery {
+public:
+    // hull as returned by run_full, CCW indices into pts
+    HullQuery(const std::vector<core::Point>& pts, const std::vector<int>& hull);
+
+    std::size_t size() const { return ids_.size(); }
+
+    // inside or on the boundary
+    bool contains(const core::Point& p) const;
+
+    // both -1 when p is inside or on the hull
+    HullTangents tangents(const core::Point& p) const;
+
+    // input index of a hull vertex maximizing dx * x + dy * y, -1 for an
+    // empty hull. ties go to either vertex
+    int extreme(double dx, double dy) const;
+
+    std::vector<unsigned char> contains(const std::vector<core::Point>& queries) const;
+    std::vector<HullTangents> tangents(const std::vector<core::Point>& queries) const;
+    // one direction per entry, the x and y of each point
+    std::vector<int> extreme(const std::vector<core::Point>& directions) const;
+
+private:
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<int> ids_;
+
+    double orient(int a, int b, double px, double py) const;
+    double orient(double px, double py, int a, int b) const;
+
+    // hull position of the largest value of a sequence over the vertices that
+    // rises once and falls once going around, less(i, j) comparing positions
+    template <class Less>
+    int cyclic_max(Less less) const;
+
+    // fan position k with p in the wedge v0 v[k] v[k + 1], p already known
+    // to be between v1 and the last vertex
+    int wedge(double px, double py) const;
+    bool contains_at(double px, double py, int k) const;
+};
+
+#endif
@@ -0,0 +1,205 @@
+#include "algorithms/hull_verifier.h"
+#include "core/geometry.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using core::Point;
+
+namespace {
+    HullVerifyResult fail(std::string msg) {
+        HullVerifyResult r;
+        r.ok = false;
+        r.error = std::move(msg);
+        return r;
+    }
+
+    // hull vertices extreme in eight directions form a convex polygon inside
+    // the hull that covers most of it. each edge as ex * y - ey * x + k >
+    // margin for points strictly inside
+    constexpr int kInnerEdges = 8;
+
+    struct InnerPolygon {
+        std::array<double, kInnerEdges> ex{}, ey{}, k{}, margin{};
+        bool usable{false};
+    };
+
+    InnerPolygon inner_polygon(const std::vector<Point>& pts, const std::vector<int>& hull) {
+        static constexpr float dir[kInnerEdges][2] = {
+            {-1.0f, 0.0f}, {-1.0f, -1.0f}, {0.0f, -1.0f}, {1.0f, -1.0f},
+            {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}, {-1.0f, 1.0f}};
+        const int h = static_cast<int>(hull.size());
+        std::array<int, kInnerEdges> pick{};
+        std::array<float, kInnerEdges> best{};
+        for (int d = 0; d < kInnerEdges; ++d) best[d] = -std::numeric_limits<float>::infinity();
+        for (int i = 0; i < h; ++i) {
+            const Point& p = pts[hull[i]];
+            for (int d = 0; d < kInnerEdges; ++d) {
+                const float v = dir[d][0] * p.x + dir[d][1] * p.y;
+                if (v > best[d]) { best[d] = v; pick[d] = i; }
+            }
+        }
+        // positions along the hull keep the polygon CCW
+        std::sort(pick.begin(), pick.end());
+        const int m = static_cast<int>(std::unique(pick.begin(), pick.end()) - pick.begin());
+
+        InnerPolygon q;
+        if (m < 3) return q;
+        for (int e = 0; e < kInnerEdges; ++e) {
+            // fewer distinct vertices repeat the last edge
+            const int from = std::min(e, m - 1);
+            const Point& a = pts[hull[pick[from]]];
+            const Point& b = pts[hull[pick[(from + 1) % m]]];
+            q.ex[e] = static_cast<double>(b.x) - a.x;
+            q.ey[e] = static_cast<double>(b.y) - a.y;
+            q.k[e] = q.ey[e] * a.x - q.ex[e] * a.y;
+            // covers the rounding of the expanded form, anything closer goes
+            // through the exact path
+            const double mag = (std::fabs(q.ex[e]) + std::fabs(q.ey[e])) *
+                               (std::fabs(a.x) + std::fabs(a.y) + std::fabs(b.x) + std::fabs(b.y) + 1.0);
+            q.margin[e] = mag * 8.0 * std::numeric_limits<double>::epsilon();
+        }
+        q.usable = true;
+        return q;
+    }
+}
+
+HullVerifier::HullVerifier(double tolerance) : tolerance_(tolerance) {}
+
+HullVerifyResult HullVerifier::verify(const std::vector<Point>& pts, const std::vector<int>& hull) const {
+    const std::size_t n = pts.size();
+    const int h = static_cast<int>(hull.size());
+    if (n == 0) return h == 0 ? HullVerifyResult{} : fail("hull of an empty input is not empty");
+    if (h == 0) return fail("empty hull for a non empty input");
+
+    for (int id : hull) {
+        if (id < 0 || static_cast<std::size_t>(id) >= n) return fail("hull index " + std::to_string(id) + " out of range");
+    }
+
+    // repeated vertices, by index and by position
+    std::vector<int> sorted(hull);
+    std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {
+        return pts[a].x < pts[b].x || (pts[a].x == pts[b].x && (pts[a].y < pts[b].y || (pts[a].y == pts[b].y && a < b)));
+    });
+    for (int i = 1; i < h; ++i) {
+        if (sorted[i] == sorted[i - 1]) return fail("hull index " + std::to_string(sorted[i]) + " repeated");
+        if (core::same_position(pts[sorted[i]], pts[sorted[i - 1]])) {
+            return fail("hull indices " + std::to_string(sorted[i - 1]) + " and " + std::to_string(sorted[i]) + " share a position");
+        }
+    }
+
+    // absolute slack for the containment test, from the hull's bounding box
+    // which is the input's when the hull is right
+    float min_x = pts[hull[0]].x, max_x = min_x, min_y = pts[hull[0]].y, max_y = min_y;
+    for (int id : hull) {
+        min_x = std::min(min_x, pts[id].x);
+        max_x = std::max(max_x, pts[id].x);
+        min_y = std::min(min_y, pts[id].y);
+        max_y = std::max(max_y, pts[id].y);
+    }
+    const double slack = tolerance_ * std::hypot(static_cast<double>(max_x) - min_x, static_cast<double>(max_y) - min_y);
+
+    // strict convexity and CCW order. every turn is left, and every vertex is
+    // left of the ray from the first to the second vertex, which rules out a
+    // polygon that winds around more than once
+    if (h >= 3) {
+        const Point& v0 = pts[hull[0]];
+        const Point& v1 = pts[hull[1]];
+        for (int i = 0; i < h; ++i) {
+            const Point& a = pts[hull[i]];
+            const Point& b = pts[hull[(i + 1) % h]];
+            const Point& c = pts[hull[(i + 2) % h]];
+            const double turn = core::orient(a, b, c);
+            if (turn < 0.0) return fail("reflex vertex " + std::to_string(hull[(i + 1) % h]) + ", hull not CCW or not convex");
+            if (turn == 0.0) return fail("collinear vertex " + std::to_string(hull[(i + 1) % h]) + ", hull not strictly convex");
+            if (i >= 2 && core::orient(v0, v1, a) < 0.0) return fail("hull winds around more than once");
+        }
+    }
+
+    // containment. h of 1 or 2 means all points sit on that point or segment
+    auto on_segment = [&](const Point& a, const Point& b, const Point& p) {
+        const double len2 = core::dist2(a, b);
+        double t = 0.0;
+        if (len2 > 0.0) {
+            t = ((static_cast<double>(p.x) - a.x) * (static_cast<double>(b.x) - a.x) +
+                 (static_cast<double>(p.y) - a.y) * (static_cast<double>(b.y) - a.y)) / len2;
+            t = std::clamp(t, 0.0, 1.0);
+        }
+        const double ex = a.x + t * (static_cast<double>(b.x) - a.x) - p.x;
+        const double ey = a.y + t * (static_cast<double>(b.y) - a.y) - p.y;
+        return ex * ex + ey * ey <= slack * slack;
+    };
+
+    // is p inside the fan of hull[0], binary search for its wedge and test
+    // the one edge closing it
+    auto inside = [&](const Point& p) {
+        if (h == 1) return on_segment(pts[hull[0]], pts[hull[0]], p);
+        if (h == 2) return on_segment(pts[hull[0]], pts[hull[1]], p);
+        const Point& v0 = pts[hull[0]];
+        const Point& v1 = pts[hull[1]];
+        const Point& vl = pts[hull[h - 1]];
+        if (core::orient(v0, v1, p) < 0.0 || core::orient(v0, vl, p) > 0.0) {
+            // outside the fan, so outside the hull. with a large tolerance
+            // it can still be within slack of an edge away from v0, only
+            // points that are wrong or close to wrong get here
+            for (int i = 0; i < h; ++i) {
+                const Point& a = pts[hull[i]];
+                const Point& b = pts[hull[(i + 1) % h]];
+                if (core::orient(a, b, p) < -slack * core::dist(a, b)) return false;
+            }
+            return true;
+        }
+        int lo = 1;
+        int hi = h - 1;
+        while (hi - lo > 1) {
+            const int mid = (lo + hi) / 2;
+            if (core::orient(v0, pts[hull[mid]], p) >= 0.0) lo = mid;
+            else hi = mid;
+        }
+        const Point& a = pts[hull[lo]];
+        const Point& b = pts[hull[hi]];
+        return core::orient(a, b, p) >= -slack * core::dist(a, b);
+    };
+
+    const InnerPolygon inner = h >= 3 ? inner_polygon(pts, hull) : InnerPolygon{};
+    const std::size_t chunks = core::chunk_count(n);
+    std::vector<std::size_t> outside(chunks, 0);
+    std::vector<int> first(chunks, -1);
+
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        constexpr std::size_t kBlock = 1024;
+        std::array<unsigned char, kBlock> maybe_out{};
+        for (std::size_t base = begin; base < end; base += kBlock) {
+            const std::size_t len = std::min(kBlock, end - base);
+            // branch free prefilter, one flag per point left for the exact test
+            if (inner.usable) {
+                for (std::size_t j = 0; j < len; ++j) {
+                    const double x = pts[base + j].x;
+                    const double y = pts[base + j].y;
+                    bool in = true;
+                    for (int e = 0; e < kInnerEdges; ++e) in &= inner.ex[e] * y - inner.ey[e] * x + inner.k[e] > inner.margin[e];
+                    maybe_out[j] = !in;
+                }
+            } else {
+                std::fill(maybe_out.begin(), maybe_out.begin() + len, 1);
+            }
+            for (std::size_t j = 0; j < len; ++j) {
+                if (!maybe_out[j] || inside(pts[base + j])) continue;
+                if (outside[w]++ == 0) first[w] = static_cast<int>(base + j);
+            }
+        }
+    });
+
+    HullVerifyResult r;
+    for (std::size_t c = 0; c < chunks; ++c) {
+        r.outside += outside[c];
+        if (first[c] >= 0 && (r.first_outside < 0 || first[c] < r.first_outside)) r.first_outside = first[c];
+    }
+    if (r.outside > 0) {
+        r.ok = false;
+        r.error = std::to_string(r.outside) + " points outside the hull, first " + std::to_string(r.first_outside);
+    }
+    return r;
+}
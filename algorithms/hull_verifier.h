@@ -0,0 +1,32 @@
+#ifndef ALGORITHMS_HULL_VERIFIER_H
+#define ALGORITHMS_HULL_VERIFIER_H
+
+#include <string>
+#include <vector>
+#include "core/types.h"
+
+struct HullVerifyResult {
+    bool ok{true};
+    std::string error;       // first problem found, empty when ok
+    std::size_t outside{0};  // input points outside the hull
+    int first_outside{-1};   // lowest index of such a point
+};
+
+// checks a run_full result against its input: indices in range, no vertex
+// repeated by index or position, CCW order, strictly convex, and every input
+// point inside or on the hull. the containment pass is a binary search over
+// the fan from the first vertex, so O(n log h), split over threads, with a
+// branch free inner polygon test in front that settles most points in O(1)
+class HullVerifier {
+public:
+    // points up to tolerance times the bounding box diagonal outside an edge
+    // still count as on the hull, float algorithms round at about that scale
+    explicit HullVerifier(double tolerance = 1e-6);
+
+    HullVerifyResult verify(const std::vector<core::Point>& pts, const std::vector<int>& hull) const;
+
+private:
+    double tolerance_;
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include "algorithms/jarvis_march.h"
+#include "core/parallel.h"
+#include <array>
+#include <stdexcept>
+
+using core::Point;
+
+namespace {
+    // a candidate relative to the current vertex, p - c in double, exact for
+    // float input
+    struct Candidate {
+        double dx{0.0};
+        double dy{0.0};
+        double d2{0.0};
+        int id{-1};
+    };
+
+    // p replaces best when it is right of the ray to best, or on it and
+    // farther. best starting at the vertex itself loses to any other position
+    inline bool beats(const Candidate& best, double px, double py, double pd2) {
+        const double o = best.dx * py - best.dy * px;
+        return o < 0.0 || (o == 0.0 && pd2 > best.d2);
+    }
+
+    // lanes scanned side by side, each a select per point with no branch
+    constexpr int kLanes = 8;
+    // a scan per hull vertex, threads only pay off on large inputs
+    constexpr std::size_t kMinChunk = 1u << 16;
+}
+
+JarvisMarch::JarvisMarch(int max_hull) : max_hull_(max_hull) {
+    if (max_hull_ < 3) throw std::runtime_error("jarvis march needs room for at least three hull vertices");
+}
+
+void JarvisMarch::reset(const std::vector<Point>& pts) {
+    reset(std::vector<Point>(pts));
+}
+
+void JarvisMarch::reset(std::vector<Point>&& pts) {
+    points_ = std::move(pts);
+    xs_.resize(points_.size());
+    ys_.resize(points_.size());
+    for (std::size_t i = 0; i < points_.size(); ++i) {
+        xs_[i] = points_[i].x;
+        ys_[i] = points_[i].y;
+    }
+    use_fallback_ = false;
+    frames_.clear();
+    frame_pos_ = 0;
+    fr_ = core::HullFrame{};
+}
+
+int JarvisMarch::start_index() const {
+    int idx = 0;
+    sliced("start", points_.size(), [&](std::size_t begin, std::size_t end) {
+        for (int i = static_cast<int>(begin); i < static_cast<int>(end); ++i) {
+            if (xs_[i] < xs_[idx] || (xs_[i] == xs_[idx] && ys_[i] < ys_[idx])) idx = i;
+        }
+    });
+    return idx;
+}
+
+int JarvisMarch::next_vertex(int c) const {
+    const std::size_t n = points_.size();
+    const double cx = xs_[c];
+    const double cy = ys_[c];
+    std::vector<Candidate> per_worker(core::chunk_count(n, kMinChunk));
+
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        std::array<double, kLanes> bx{};
+        std::array<double, kLanes> by{};
+        std::array<double, kLanes> bd{};
+        std::array<int, kLanes> bi{};
+        bi.fill(c);
+        // slices of kCheckEvery, a multiple of kLanes, between looks at the
+        // stop token. a stopped worker leaves garbage that is never used
+        std::size_t i = begin;
+        while (i + kLanes <= end) {
+            if (stop_requested()) return;
+            const std::size_t slice_end = std::min(end, i + kCheckEvery);
+            for (; i + kLanes <= slice_end; i += kLanes) {
+                for (int l = 0; l < kLanes; ++l) {
+                    const double px = xs_[i + l] - cx;
+                    const double py = ys_[i + l] - cy;
+                    const double pd = px * px + py * py;
+                    const double o = bx[l] * py - by[l] * px;
+                    const bool take = o < 0.0 || (o == 0.0 && pd > bd[l]);
+                    bx[l] = take ? px : bx[l];
+                    by[l] = take ? py : by[l];
+                    bd[l] = take ? pd : bd[l];
+                    bi[l] = take ? static_cast<int>(i + l) : bi[l];
+                }
+            }
+        }
+        Candidate best{0.0, 0.0, 0.0, c};
+        for (int l = 0; l < kLanes; ++l) {
+            if (beats(best, bx[l], by[l], bd[l])) best = {bx[l], by[l], bd[l], bi[l]};
+        }
+        for (; i < end; ++i) {
+            const double px = xs_[i] - cx;
+            const double py = ys_[i] - cy;
+            const double pd = px * px + py * py;
+            if (beats(best, px, py, pd)) best = {px, py, pd, static_cast<int>(i)};
+        }
+        per_worker[w] = best;
+    }, kMinChunk);
+
+    Candidate best{0.0, 0.0, 0.0, c};
+    for (const Candidate& cand : per_worker) {
+        if (cand.id >= 0 && beats(best, cand.dx, cand.dy, cand.d2)) best = cand;
+    }
+    return best.id;
+}
+
+std::vector<int> JarvisMarch::march(std::vector<core::HullFrame>* frames) const {
+    std::vector<int> hull;
+    if (points_.empty()) return hull;
+
+    const int start = start_index();
+    hull.push_back(start);
+    if (frames) {
+        core::HullFrame f{};
+        f.label = "Start at lowest x";
+        f.active_a = start;
+        f.hull_indices = hull;
+        frames->push_back(std::move(f));
+    }
+
+    int c = start;
+    for (;;) {
+        int next = -1;
+        if (frames) {
+            // the same scan one point at a time, a frame per better candidate
+            Candidate best{0.0, 0.0, 0.0, c};
+            for (int i = 0; i < static_cast<int>(points_.size()); ++i) {
+                const double px = static_cast<double>(xs_[i]) - xs_[c];
+                const double py = static_cast<double>(ys_[i]) - ys_[c];
+                const double pd = px * px + py * py;
+                if (!beats(best, px, py, pd)) continue;
+                best = {px, py, pd, i};
+                core::HullFrame f{};
+                f.label = "More clockwise candidate";
+                f.active_a = c;
+                f.active_b = i;
+                f.hull_indices = hull;
+                frames->push_back(std::move(f));
+            }
+            next = best.id;
+        } else {
+            next = next_vertex(c);
+            checkpoint("march", hull.size(), static_cast<std::size_t>(max_hull_));
+        }
+
+        // back at the start, or every point on the vertex itself
+        if (next == c || (xs_[next] == xs_[start] && ys_[next] == ys_[start])) break;
+        if (static_cast<int>(hull.size()) == max_hull_) return {};
+        hull.push_back(next);
+        if (frames) {
+            core::HullFrame f{};
+            f.label = "Wrap to next vertex";
+            f.active_a = c;
+            f.active_b = next;
+            f.hull_indices = hull;
+            frames->push_back(std::move(f));
+        }
+        c = next;
+    }
+
+    if (frames) {
+        core::HullFrame f{};
+        f.label = "Done";
+        f.hull_indices = hull;
+        frames->push_back(std::move(f));
+    }
+    return hull;
+}
+
+std::vector<int> JarvisMarch::run_full() {
+    std::vector<int> hull = march(nullptr);
+    use_fallback_ = hull.empty() && !points_.empty();
+    if (!use_fallback_) return hull;
+    fallback_.reset(points_);
+    return run_nested(fallback_);
+}
+
+void JarvisMarch::begin_stepping() {
+    frames_.clear();
+    std::vector<int> hull = march(&frames_);
+    use_fallback_ = hull.empty() && !points_.empty();
+    if (use_fallback_) {
+        frames_.clear();
+        fallback_.reset(points_);
+        fallback_.begin_stepping();
+        return;
+    }
+    if (frames_.empty()) {
+        core::HullFrame f{};
+        f.label = "No points";
+        frames_.push_back(std::move(f));
+    }
+    frame_pos_ = 0;
+    fr_ = frames_.front();
+}
+
+bool JarvisMarch::step() {
+    if (use_fallback_) return fallback_.step();
+    if (frames_.empty()) return false;
+    if (frame_pos_ + 1 >= frames_.size()) return false;
+    ++frame_pos_;
+    fr_ = frames_[frame_pos_];
+    return frame_pos_ + 1 < frames_.size();
+}
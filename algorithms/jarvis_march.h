@@ -0,0 +1,57 @@
+#ifndef ALGORITHMS_JARVIS_MARCH_H
+#define ALGORITHMS_JARVIS_MARCH_H
+
+#include "algorithms/convex_hull_algorithm.h"
+#include "algorithms/quickhull.h"
+#include "core/types.h"
+#include <vector>
+
+// gift wrapping, O(n h) with no sort. each next vertex is one pass over flat
+// coordinate arrays that keeps the most clockwise point in several
+// independent lanes, split over threads, the lanes reduced at the end. the
+// order is total because every point is on one side of a hull vertex. past
+// max_hull vertices the march stops and Quickhull takes over, so a large hull
+// never costs O(n^2). the default stays well under the 30 to 40 vertices of
+// uniform random inputs from 1e5 points up, where Quickhull is faster
+class JarvisMarch final : public ConvexHullAlgorithm {
+public:
+    explicit JarvisMarch(int max_hull = 16);
+
+    const char* name() const override { return "Jarvis"; }
+
+    void reset(const std::vector<core::Point>& pts) override;
+    void reset(std::vector<core::Point>&& pts) override;
+    std::vector<int> run_full() override;
+
+    void begin_stepping() override;
+    bool step() override;
+    const core::HullFrame& frame() const override { return use_fallback_ ? fallback_.frame() : fr_; }
+    std::size_t frame_count() const override { return use_fallback_ ? fallback_.frame_count() : frames_.size(); }
+
+    // whether the last run handed over to Quickhull
+    bool handed_over() const { return use_fallback_; }
+
+private:
+    int max_hull_;
+    std::vector<core::Point> points_;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+
+    Quickhull fallback_;
+    bool use_fallback_{false};
+
+    // precomputed frames
+    std::vector<core::HullFrame> frames_;
+    std::size_t frame_pos_{0};
+    core::HullFrame fr_{};
+
+    // lowest x, then lowest y
+    int start_index() const;
+    // the point every other one is left of, seen from hull vertex c.
+    // collinear ties go to the farther point
+    int next_vertex(int c) const;
+    // the march, empty when it passed max_hull_
+    std::vector<int> march(std::vector<core::HullFrame>* frames) const;
+};
+
+#endif
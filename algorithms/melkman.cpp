@@ -0,0 +1,189 @@
+#include "algorithms/melkman.h"
+#include "core/geometry.h"
+#include <cmath>
+
+using core::Point;
+
+void MelkmanAlgorithm::reset(const std::vector<Point>& pts) {
+    reset(std::vector<Point>(pts));
+}
+
+void MelkmanAlgorithm::reset(std::vector<Point>&& pts) {
+    points_ = std::move(pts);
+    use_fallback_ = false;
+    frames_.clear();
+    frame_pos_ = 0;
+    fr_ = core::HullFrame{};
+}
+
+bool MelkmanAlgorithm::is_simple_polyline(const std::vector<Point>& pts, const std::function<void(std::size_t)>& poll) {
+    const std::size_t n = pts.size();
+    auto at = [&](std::size_t i) {
+        if (poll && i % kCheckEvery == 0) poll(i);
+    };
+    if (n < 3) return true;
+
+    // strictly monotone in x
+    bool inc = true;
+    bool dec = true;
+    for (std::size_t i = 1; i < n && (inc || dec); ++i) {
+        at(i);
+        inc = inc && pts[i].x > pts[i - 1].x;
+        dec = dec && pts[i].x < pts[i - 1].x;
+    }
+    if (inc || dec) return true;
+
+    // strictly monotone in angle around the centroid. every segment then
+    // sweeps its own wedge, so no two of them can cross
+    double sx = 0.0;
+    double sy = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        at(i);
+        sx += pts[i].x;
+        sy += pts[i].y;
+    }
+    const Point c{static_cast<float>(sx / static_cast<double>(n)), static_cast<float>(sy / static_cast<double>(n)), -1};
+
+    const double first = core::orient(c, pts[0], pts[1]);
+    if (first == 0.0) return false;
+    const double sign = first > 0.0 ? 1.0 : -1.0;
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        at(i);
+        if (sign * core::orient(c, pts[i], pts[i + 1]) <= 0.0) return false;
+        // at most one full turn. the angle only grows, so getting from the
+        // half turn behind the first point's ray, or from the ray itself, to
+        // the half turn ahead of it means passing that ray a second time. the
+        // point half a turn round is on the line as well, but the next one
+        // from there is behind
+        if (i > 0 && sign * core::orient(c, pts[0], pts[i]) <= 0.0 && sign * core::orient(c, pts[0], pts[i + 1]) > 0.0) return false;
+    }
+    return true;
+}
+
+core::HullFrame MelkmanAlgorithm::make_frame(const char* label,
+                                             int a, int b, int c,
+                                             const std::vector<int>& deque, int bot, int top) {
+    core::HullFrame f{};
+    f.label = label;
+    f.active_a = a;
+    f.active_b = b;
+    f.active_c = c;
+    if (top > bot) f.hull_indices.assign(deque.begin() + bot, deque.begin() + top);
+    return f;
+}
+
+std::vector<int> MelkmanAlgorithm::melkman(std::vector<core::HullFrame>* frames) const {
+    const int n = static_cast<int>(points_.size());
+    std::vector<int> d;
+    if (n == 0) return {};
+
+    // base segment, the first point and the last one on the line through the
+    // first two distinct points. the precheck keeps that run in order
+    int b = 1;
+    while (b < n && core::same_position(points_[b], points_[0])) ++b;
+    if (b == n) return {0};
+    int c = b + 1;
+    while (c < n && core::orient(points_[0], points_[b], points_[c]) == 0.0) ++c;
+    if (c == n) {
+        // all collinear, the hull is the two extremes
+        int lo = 0;
+        int hi = 0;
+        for (int i = 1; i < n; ++i) {
+            const Point& p = points_[i];
+            if (p.x < points_[lo].x || (p.x == points_[lo].x && p.y < points_[lo].y)) lo = i;
+            if (p.x > points_[hi].x || (p.x == points_[hi].x && p.y > points_[hi].y)) hi = i;
+        }
+        return {lo, hi};
+    }
+    b = c - 1;
+
+    // d[bot] and d[top] are both the newest hull vertex, d[bot, top) is CCW
+    d.assign(2 * static_cast<std::size_t>(n) + 2, -1);
+    int bot = n;
+    int top = bot + 3;
+    if (core::orient(points_[0], points_[b], points_[c]) > 0.0) {
+        d[bot] = c; d[bot + 1] = 0; d[bot + 2] = b; d[top] = c;
+    } else {
+        d[bot] = c; d[bot + 1] = b; d[bot + 2] = 0; d[top] = c;
+    }
+    if (frames) frames->push_back(make_frame("Start triangle", 0, b, c, d, bot, top));
+
+    for (int i = c + 1; i < n; ++i) {
+        if (static_cast<std::size_t>(i) % kCheckEvery == 0) checkpoint("deque", static_cast<std::size_t>(i), static_cast<std::size_t>(n));
+        const Point& v = points_[i];
+        if (core::orient(points_[d[top - 1]], points_[d[top]], v) > 0.0 &&
+            core::orient(points_[d[bot]], points_[d[bot + 1]], v) > 0.0) {
+            if (frames) frames->push_back(make_frame("Inside, skip", d[top - 1], d[top], i, d, bot, top));
+            continue;
+        }
+        while (core::orient(points_[d[top - 1]], points_[d[top]], v) <= 0.0) {
+            if (frames) frames->push_back(make_frame("Remove from top", d[top - 1], d[top], i, d, bot, top));
+            --top;
+        }
+        d[++top] = i;
+        while (core::orient(v, points_[d[bot]], points_[d[bot + 1]]) <= 0.0) {
+            if (frames) frames->push_back(make_frame("Remove from bottom", d[bot], d[bot + 1], i, d, bot, top));
+            ++bot;
+        }
+        d[--bot] = i;
+        if (frames) frames->push_back(make_frame("Add to both ends", d[top - 1], i, d[bot + 1], d, bot, top));
+    }
+
+    // the newest point can end up collinear with its neighbours, nothing
+    // after it could have removed it
+    std::vector<int> hull;
+    hull.reserve(top - bot);
+    for (int k = bot; k < top; ++k) {
+        while (hull.size() >= 2 && core::orient(points_[hull[hull.size() - 2]], points_[hull.back()], points_[d[k]]) <= 0.0) hull.pop_back();
+        hull.push_back(d[k]);
+    }
+    while (hull.size() >= 3 && core::orient(points_[hull[hull.size() - 2]], points_[hull.back()], points_[hull[0]]) <= 0.0) hull.pop_back();
+    while (hull.size() >= 3 && core::orient(points_[hull.back()], points_[hull[0]], points_[hull[1]]) <= 0.0) hull.erase(hull.begin());
+
+    if (frames) {
+        core::HullFrame done{};
+        done.label = "Done";
+        done.hull_indices = hull;
+        frames->push_back(std::move(done));
+    }
+    return hull;
+}
+
+std::vector<int> MelkmanAlgorithm::run_full() {
+    use_fallback_ = !is_simple_polyline(points_, [this](std::size_t done) { checkpoint("precheck", done, points_.size()); });
+    if (use_fallback_) {
+        fallback_.reset(points_);
+        return run_nested(fallback_);
+    }
+    return melkman(nullptr);
+}
+
+void MelkmanAlgorithm::begin_stepping() {
+    use_fallback_ = !is_simple_polyline(points_);
+    if (use_fallback_) {
+        fallback_.reset(points_);
+        fallback_.begin_stepping();
+        return;
+    }
+
+    frames_.clear();
+    std::vector<int> hull = melkman(&frames_);
+    if (frames_.empty()) {
+        // fewer than three distinct or all collinear
+        core::HullFrame f{};
+        f.label = "Done";
+        f.hull_indices = std::move(hull);
+        frames_.push_back(std::move(f));
+    }
+    frame_pos_ = 0;
+    fr_ = frames_.front();
+}
+
+bool MelkmanAlgorithm::step() {
+    if (use_fallback_) return fallback_.step();
+    if (frames_.empty()) return false;
+    if (frame_pos_ + 1 >= frames_.size()) return false;
+    ++frame_pos_;
+    fr_ = frames_[frame_pos_];
+    return frame_pos_ + 1 < frames_.size();
+}
@@ -0,0 +1,58 @@
+#ifndef ALGORITHMS_MELKMAN_H
+#define ALGORITHMS_MELKMAN_H
+
+#include "algorithms/andrew_algorithm.h"
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+#include <functional>
+#include <vector>
+
+// Melkman's deque hull, O(n) without sorting, for input that is a simple
+// polyline in the given order (polygon rings, tracks). input that fails the
+// precheck goes to Andrew, so any point set gives the right hull. the routing
+// only goes that way: the other algorithms never try the precheck, a caller
+// whose input is mostly polylines picks this one as its algorithm
+class MelkmanAlgorithm final : public ConvexHullAlgorithm {
+public:
+    MelkmanAlgorithm() = default;
+
+    const char* name() const override { return "Melkman"; }
+
+    void reset(const std::vector<core::Point>& pts) override;
+    void reset(std::vector<core::Point>&& pts) override;
+    std::vector<int> run_full() override;
+
+    void begin_stepping() override;
+    bool step() override;
+    const core::HullFrame& frame() const override { return use_fallback_ ? fallback_.frame() : fr_; }
+    std::size_t frame_count() const override { return use_fallback_ ? fallback_.frame_count() : frames_.size(); }
+
+    // whether the last run failed the precheck and went to Andrew
+    bool handed_over() const { return use_fallback_; }
+
+    // sufficient test in one pass: strictly monotone in x, or strictly
+    // monotone in angle around the centroid with at most one full turn.
+    // either one makes the polyline simple. poll, when given, is called with
+    // the position every kCheckEvery points and may throw to stop the test
+    static bool is_simple_polyline(const std::vector<core::Point>& pts,
+                                   const std::function<void(std::size_t)>& poll = {});
+
+private:
+    std::vector<core::Point> points_;
+    AndrewAlgorithm fallback_;
+    bool use_fallback_{false};
+
+    // precomputed frames
+    std::vector<core::HullFrame> frames_;
+    std::size_t frame_pos_{0};
+    core::HullFrame fr_{};
+
+    // the deque pass, records frames when given somewhere to put them
+    std::vector<int> melkman(std::vector<core::HullFrame>* frames) const;
+
+    static core::HullFrame make_frame(const char* label,
+                                      int a, int b, int c,
+                                      const std::vector<int>& deque, int bot, int top);
+};
+
+#endif
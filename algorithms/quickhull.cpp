@@ -1,4 +1,5 @@
 #include "algorithms/quickhull.h"
+#include "algorithms/hull_query.h"
 #include <algorithm>
 #include <iostream>
 #include <limits>
@@ -8,7 +9,11 @@
 using core::Point;
 
 void Quickhull::reset(const std::vector<Point>& pts) {
-    points_ = pts;
+    reset(std::vector<Point>(pts));
+}
+
+void Quickhull::reset(std::vector<Point>&& pts) {
+    points_ = std::move(pts);
     frames_.clear();
     frame_pos_ = 0;
     fr_ = core::HullFrame{};
@@ -17,44 +22,65 @@ void Quickhull::reset(const std::vector<Point>& pts) {
 int Quickhull::leftmost_index() const {
     if (points_.empty()) return -1;
     int idx = 0;
-    for (int i = 1; i < static_cast<int>(points_.size()); ++i) {
-        if (points_[i].x < points_[idx].x ||
-            (points_[i].x == points_[idx].x && points_[i].y < points_[idx].y)) {
-            idx = i;
+    sliced("extremes", points_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const int i = static_cast<int>(k);
+            if (points_[i].x < points_[idx].x ||
+                (points_[i].x == points_[idx].x && points_[i].y < points_[idx].y)) {
+                idx = i;
+            }
         }
-    }
+    });
     return idx;
 }
 
 int Quickhull::rightmost_index() const {
     if (points_.empty()) return -1;
     int idx = 0;
-    for (int i = 1; i < static_cast<int>(points_.size()); ++i) {
-        if (points_[i].x > points_[idx].x ||
-            (points_[i].x == points_[idx].x && points_[i].y > points_[idx].y)) {
-            idx = i;
+    sliced("extremes", points_.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const int i = static_cast<int>(k);
+            if (points_[i].x > points_[idx].x ||
+                (points_[i].x == points_[idx].x && points_[i].y > points_[idx].y)) {
+                idx = i;
+            }
         }
-    }
+    });
     return idx;
 }
 
-void Quickhull::chain_ccw(const std::vector<Point>& pts,
-                          int a, int b,
+void Quickhull::chain_ccw(int a, int b,
                           const std::vector<int>& candidates,
                           std::vector<int>& out) {
+    const std::vector<Point>& pts = points_;
+    const std::size_t m = candidates.size();
+    // both passes in slices with a tick after each, a deep recursion of
+    // small calls piles its work up there as well
+    auto scan = [&](auto&& visit) {
+        for (std::size_t begin = 0; begin < m; begin += kCheckEvery) {
+            const std::size_t end = std::min(m, begin + kCheckEvery);
+            for (std::size_t k = begin; k < end; ++k) visit(candidates[k]);
+            tick(end - begin, "recurse", settled_, split_);
+        }
+    };
+
     // find farthest from segment ab among points left of ab
     int far = -1;
-    float best = 0.0f;
-    for (int idx : candidates) {
-        float area2 = cross(pts[a], pts[b], pts[idx]);
-        if (area2 > 0.0f) {
-            float val = std::abs(area2); // distance proxy
-            if (val > best) { best = val; far = idx; }
+    double best = 0.0;
+    scan([&](int idx) {
+        double area2 = cross(pts[a], pts[b], pts[idx]);
+        if (area2 > 0.0) {
+            double val = std::abs(area2); // distance proxy
+            if (val > best || (val == best && farther_along(pts[a], pts[b], pts[idx], pts[far]))) {
+                best = val;
+                far = idx;
+            }
         }
-    }
+    });
 
     if (far == -1) {
         // no point strictly left of ab, fix a
+        settled_ += m;
         out.push_back(a);
         return;
     }
@@ -62,28 +88,38 @@ void Quickhull::chain_ccw(const std::vector<Point>& pts,
     // split candidates into the two subproblems
     std::vector<int> left_ac;
     std::vector<int> left_cb;
-    left_ac.reserve(candidates.size());
-    left_cb.reserve(candidates.size());
-    for (int idx : candidates) {
-        if (idx == far) continue;
-        float s1 = cross(pts[a], pts[far], pts[idx]);
-        float s2 = cross(pts[far], pts[b], pts[idx]);
-        if (s1 > 0.0f) left_ac.push_back(idx);
-        else if (s2 > 0.0f) left_cb.push_back(idx);
+    left_ac.reserve(m);
+    left_cb.reserve(m);
+    scan([&](int idx) {
+        if (idx == far) return;
+        double s1 = cross(pts[a], pts[far], pts[idx]);
+        double s2 = cross(pts[far], pts[b], pts[idx]);
+        if (s1 > 0.0) left_ac.push_back(idx);
+        else if (s2 > 0.0) left_cb.push_back(idx);
         // collinear or right of both halves are ignored
-    }
+    });
+    settled_ += m - left_ac.size() - left_cb.size();
 
-    chain_ccw(pts, a, far, left_ac, out);
-    chain_ccw(pts, far, b, left_cb, out);
+    chain_ccw(a, far, left_ac, out);
+    chain_ccw(far, b, left_cb, out);
 }
 
-std::vector<int> Quickhull::build_hull_ccw() const {
+std::vector<int> Quickhull::build_hull_ccw(const std::vector<int>* subset) {
     std::vector<int> hull;
-    if (points_.empty()) return hull;
-    if (points_.size() == 1) { hull.push_back(0); return hull; }
-
-    int L = leftmost_index();
-    int R = rightmost_index();
+    const int m = subset ? static_cast<int>(subset->size()) : static_cast<int>(points_.size());
+    auto at = [&](int k) { return subset ? (*subset)[k] : k; };
+    if (m == 0) return hull;
+    if (m == 1) { hull.push_back(at(0)); return hull; }
+
+    int L = subset ? at(0) : leftmost_index();
+    int R = subset ? at(0) : rightmost_index();
+    if (subset) {
+        for (int k = 1; k < m; ++k) {
+            const int i = at(k);
+            if (points_[i].x < points_[L].x || (points_[i].x == points_[L].x && points_[i].y < points_[L].y)) L = i;
+            if (points_[i].x > points_[R].x || (points_[i].x == points_[R].x && points_[i].y > points_[R].y)) R = i;
+        }
+    }
     if (L == -1 || R == -1 || L == R) {
         hull.push_back(L == -1 ? 0 : L);
         return hull;
@@ -91,24 +127,31 @@ std::vector<int> Quickhull::build_hull_ccw() const {
 
     std::vector<int> above;
     std::vector<int> below;
-    above.reserve(points_.size());
-    below.reserve(points_.size());
-    for (int i = 0; i < static_cast<int>(points_.size()); ++i) {
-        if (i == L || i == R) continue;
-        float s = cross(points_[L], points_[R], points_[i]);
-        if (s > 0.0f) above.push_back(i);
-        else if (s < 0.0f) below.push_back(i);
-        // collinear with LR are ignored, endpoints carry that edge
-    }
+    above.reserve(m);
+    below.reserve(m);
+    sliced("split", static_cast<std::size_t>(m), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const int i = at(static_cast<int>(k));
+            if (i == L || i == R) continue;
+            double s = cross(points_[L], points_[R], points_[i]);
+            if (s > 0.0) above.push_back(i);
+            else if (s < 0.0) below.push_back(i);
+            // collinear with LR are ignored, endpoints carry that edge
+        }
+    });
 
     std::vector<int> top;
     std::vector<int> bot;
-    chain_ccw(points_, L, R, above, top); // L to R without R
-    chain_ccw(points_, R, L, below, bot); // R to L without L
+    settled_ = 0;
+    split_ = above.size() + below.size();
+    chain_ccw(L, R, above, top); // L to R without R
+    chain_ccw(R, L, below, bot); // R to L without L
 
     hull.reserve(top.size() + bot.size());
     hull.insert(hull.end(), top.begin(), top.end());
     hull.insert(hull.end(), bot.begin(), bot.end());
+    // the chains run clockwise (left of LR is above), flip to CCW
+    std::reverse(hull.begin(), hull.end());
     return hull;
 }
 
@@ -116,6 +159,31 @@ std::vector<int> Quickhull::run_full() {
     return build_hull_ccw();
 }
 
+std::vector<int> Quickhull::run_warm(const std::vector<int>& hint) {
+    warm_fell_back_ = true;
+    const std::size_t n = points_.size();
+    for (int id : hint) {
+        if (id < 0 || static_cast<std::size_t>(id) >= n) return build_hull_ccw();
+    }
+
+    // the old vertices at their new places, made convex again
+    std::vector<int> inner = build_hull_ccw(&hint);
+    if (inner.size() < 3) return build_hull_ccw();
+
+    // points inside or on that polygon cannot be vertices
+    std::vector<unsigned char> inside = HullQuery(points_, inner).contains(points_);
+    std::vector<int> candidates(inner);
+    const std::size_t limit = inner.size() + n / kWarmLimit;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (inside[i]) continue;
+        candidates.push_back(static_cast<int>(i));
+        if (candidates.size() > limit) return build_hull_ccw();
+    }
+
+    warm_fell_back_ = false;
+    return build_hull_ccw(&candidates);
+}
+
 core::HullFrame Quickhull::make_frame(const char* label,
                                       int a, int b, int c,
                                       const std::vector<int>& upper,
@@ -142,12 +210,15 @@ void Quickhull::chain_ccw_with_frames(const std::vector<Point>& pts,
                                       std::vector<core::HullFrame>& frames) {
     // find farthest on the left of ab
     int far = -1;
-    float best = 0.0f;
+    double best = 0.0;
     for (int idx : candidates) {
-        float area2 = cross(pts[a], pts[b], pts[idx]);
-        if (area2 > 0.0f) {
-            float val = std::abs(area2);
-            if (val > best) { best = val; far = idx; }
+        double area2 = cross(pts[a], pts[b], pts[idx]);
+        if (area2 > 0.0) {
+            double val = std::abs(area2);
+            if (val > best || (val == best && farther_along(pts[a], pts[b], pts[idx], pts[far]))) {
+                best = val;
+                far = idx;
+            }
         }
     }
 
@@ -166,10 +237,10 @@ void Quickhull::chain_ccw_with_frames(const std::vector<Point>& pts,
     left_cb.reserve(candidates.size());
     for (int idx : candidates) {
         if (idx == far) continue;
-        float s1 = cross(pts[a], pts[far], pts[idx]);
-        float s2 = cross(pts[far], pts[b], pts[idx]);
-        if (s1 > 0.0f) left_ac.push_back(idx);
-        else if (s2 > 0.0f) left_cb.push_back(idx);
+        double s1 = cross(pts[a], pts[far], pts[idx]);
+        double s2 = cross(pts[far], pts[b], pts[idx]);
+        if (s1 > 0.0) left_ac.push_back(idx);
+        else if (s2 > 0.0) left_cb.push_back(idx);
     }
 
     chain_ccw_with_frames(pts, a,   far, left_ac, upper_chain, lower_chain, frames);
@@ -209,9 +280,9 @@ void Quickhull::build_frames() {
     below.reserve(points_.size());
     for (int i = 0; i < static_cast<int>(points_.size()); ++i) {
         if (i == L || i == R) continue;
-        float s = cross(points_[L], points_[R], points_[i]);
-        if (s > 0.0f)      above.push_back(i);
-        else if (s < 0.0f) below.push_back(i);
+        double s = cross(points_[L], points_[R], points_[i]);
+        if (s > 0.0)      above.push_back(i);
+        else if (s < 0.0) below.push_back(i);
     }
 
     frames_.push_back(make_frame("Split by LR", L, R, -1, {}, {}));
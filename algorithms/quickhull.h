@@ -2,6 +2,7 @@
 #define ALGORITHMS_QUICKHULL_H
 
 #include "algorithms/convex_hull_algorithm.h"
+#include "core/geometry.h"
 #include "core/types.h"
 #include <vector>
 
@@ -12,11 +13,22 @@ public:
     const char* name() const override { return "Quickhull"; }
 
     void reset(const std::vector<core::Point>& pts) override;
+    void reset(std::vector<core::Point>&& pts) override;
     std::vector<int> run_full() override;
 
+    // recompute after every point moved a little, given the previous hull's
+    // ids. the hull of those ids at their new positions lies inside the new
+    // hull, so only the points outside it are left for the recursion. more
+    // than one in kWarmLimit points outside, or a hint with ids out of range,
+    // means a full run instead
+    std::vector<int> run_warm(const std::vector<int>& hint);
+    // whether the last run_warm fell back to a full run
+    bool warm_fell_back() const { return warm_fell_back_; }
+
     void begin_stepping() override;
     bool step() override;
     const core::HullFrame& frame() const override { return fr_; }
+    std::size_t frame_count() const override { return frames_.size(); }
 
 private:
     std::vector<core::Point> points_;
@@ -26,23 +38,33 @@ private:
     std::size_t frame_pos_{0};
     core::HullFrame fr_{};
 
+    bool warm_fell_back_{false};
+    static constexpr std::size_t kWarmLimit = 4;
+
+    // progress of a run, points fixed or dropped out of those split off
+    std::size_t settled_{0};
+    std::size_t split_{0};
+
     // helpers
-    static inline float cross(const core::Point& a, const core::Point& b, const core::Point& c) {
-        const float abx = b.x - a.x;
-        const float aby = b.y - a.y;
-        const float acx = c.x - a.x;
-        const float acy = c.y - a.y;
-        return abx * acy - aby * acx;
+    static inline double cross(const core::Point& a, const core::Point& b, const core::Point& c) {
+        return core::orient(a, b, c);
+    }
+    // p lies beyond q in the direction of ab. of points equally far from ab
+    // only the two ends of their run are vertices, this picks the one at b's
+    // end so the rest fall strictly inside the split
+    static inline bool farther_along(const core::Point& a, const core::Point& b, const core::Point& p, const core::Point& q) {
+        return (p.x - q.x) * (b.x - a.x) + (p.y - q.y) * (b.y - a.y) > 0.0f;
     }
-    static inline float tri_area2(const core::Point& a, const core::Point& b, const core::Point& c) {
+    static inline double tri_area2(const core::Point& a, const core::Point& b, const core::Point& c) {
         return std::abs(cross(a, b, c));
     }
 
     int leftmost_index() const;
     int rightmost_index() const;
 
-    // build the final hull in CCW order without repeating endpoints
-    std::vector<int> build_hull_ccw() const;
+    // build the final hull in CCW order without repeating endpoints, over
+    // all points or only the given ones
+    std::vector<int> build_hull_ccw(const std::vector<int>* subset = nullptr);
 
     // frame building
     void build_frames();
@@ -51,11 +73,10 @@ private:
                                       const std::vector<int>& upper_chain,
                                       const std::vector<int>& lower_chain);
 
-    // quickhull chain builder used by both run full and frames
-    static void chain_ccw(const std::vector<core::Point>& pts,
-                          int a, int b,
-                          const std::vector<int>& candidates, // indices
-                          std::vector<int>& out);              // appends from a to b excluding b
+    // quickhull chain builder for run full, checkpointing as it goes
+    void chain_ccw(int a, int b,
+                   const std::vector<int>& candidates, // indices
+                   std::vector<int>& out);              // appends from a to b excluding b
 
     static void chain_ccw_with_frames(const std::vector<core::Point>& pts,
                                       int a, int b,
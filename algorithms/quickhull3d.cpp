@@ -0,0 +1,319 @@
+#include "algorithms/quickhull3d.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+using core::Point3;
+
+void Quickhull3D::reset(const std::vector<Point3>& pts) {
+    points_ = pts;
+    faces_.clear();
+    conflicts_.clear();
+    free_faces_.clear();
+    edge_origin_.clear();
+    edge_twin_.clear();
+    pending_.clear();
+    visit_.clear();
+    stamp_ = 0;
+}
+
+int Quickhull3D::acquire_face(int a, int b, int c) {
+    int f;
+    if (!free_faces_.empty()) {
+        f = free_faces_.back();
+        free_faces_.pop_back();
+    } else {
+        f = static_cast<int>(faces_.size());
+        faces_.emplace_back();
+        conflicts_.emplace_back();
+        visit_.push_back(0);
+        edge_origin_.resize(edge_origin_.size() + 3);
+        edge_twin_.resize(edge_twin_.size() + 3);
+    }
+
+    edge_origin_[3 * f]     = a;
+    edge_origin_[3 * f + 1] = b;
+    edge_origin_[3 * f + 2] = c;
+    edge_twin_[3 * f]     = -1;
+    edge_twin_[3 * f + 1] = -1;
+    edge_twin_[3 * f + 2] = -1;
+
+    const Point3& pa = points_[a];
+    const Point3& pb = points_[b];
+    const Point3& pc = points_[c];
+    const double ux = double(pb.x) - pa.x, uy = double(pb.y) - pa.y, uz = double(pb.z) - pa.z;
+    const double vx = double(pc.x) - pa.x, vy = double(pc.y) - pa.y, vz = double(pc.z) - pa.z;
+    double nx = uy * vz - uz * vy;
+    double ny = uz * vx - ux * vz;
+    double nz = ux * vy - uy * vx;
+    const double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (len > 0.0) { nx /= len; ny /= len; nz /= len; }
+
+    Face& fc = faces_[f];
+    fc.nx = nx;
+    fc.ny = ny;
+    fc.nz = nz;
+    fc.d = nx * pa.x + ny * pa.y + nz * pa.z;
+    fc.far = -1;
+    fc.far_dist = 0.0;
+    fc.alive = true;
+    conflicts_[f].clear(); // keeps capacity from the previous owner of the slot
+    return f;
+}
+
+void Quickhull3D::release_face(int f) {
+    faces_[f].alive = false;
+    conflicts_[f].clear();
+    free_faces_.push_back(f);
+}
+
+void Quickhull3D::add_conflict(int f, int p, double dist) {
+    conflicts_[f].push_back(p);
+    if (dist > faces_[f].far_dist) {
+        faces_[f].far_dist = dist;
+        faces_[f].far = p;
+    }
+}
+
+bool Quickhull3D::build_initial_simplex() {
+    const int n = static_cast<int>(points_.size());
+    if (n < 4) return false;
+
+    // tolerance scaled to the coordinate range
+    double mx = 0.0, my = 0.0, mz = 0.0;
+    int ext[6] = {0, 0, 0, 0, 0, 0}; // min x, max x, min y, max y, min z, max z
+    for (int i = 0; i < n; ++i) {
+        const Point3& p = points_[i];
+        mx = std::max(mx, static_cast<double>(std::abs(p.x)));
+        my = std::max(my, static_cast<double>(std::abs(p.y)));
+        mz = std::max(mz, static_cast<double>(std::abs(p.z)));
+        if (p.x < points_[ext[0]].x) ext[0] = i;
+        if (p.x > points_[ext[1]].x) ext[1] = i;
+        if (p.y < points_[ext[2]].y) ext[2] = i;
+        if (p.y > points_[ext[3]].y) ext[3] = i;
+        if (p.z < points_[ext[4]].z) ext[4] = i;
+        if (p.z > points_[ext[5]].z) ext[5] = i;
+    }
+    eps_ = 3.0 * DBL_EPSILON * (mx + my + mz);
+
+    auto sub = [&](int a, int b, double& x, double& y, double& z) {
+        x = double(points_[a].x) - points_[b].x;
+        y = double(points_[a].y) - points_[b].y;
+        z = double(points_[a].z) - points_[b].z;
+    };
+
+    // most distant pair of extremes
+    int v0 = ext[0], v1 = ext[1];
+    double best = -1.0;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = i + 1; j < 6; ++j) {
+            double x, y, z;
+            sub(ext[i], ext[j], x, y, z);
+            double d2 = x * x + y * y + z * z;
+            if (d2 > best) { best = d2; v0 = ext[i]; v1 = ext[j]; }
+        }
+    }
+    if (std::sqrt(best) <= eps_) return false;
+
+    // farthest from the line v0 v1
+    double dx, dy, dz;
+    sub(v1, v0, dx, dy, dz);
+    int v2 = -1;
+    best = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double x, y, z;
+        sub(i, v0, x, y, z);
+        double cx = y * dz - z * dy;
+        double cy = z * dx - x * dz;
+        double cz = x * dy - y * dx;
+        double d2 = cx * cx + cy * cy + cz * cz;
+        if (d2 > best) { best = d2; v2 = i; }
+    }
+    if (v2 < 0 || std::sqrt(best) <= eps_ * std::sqrt(dx * dx + dy * dy + dz * dz)) return false;
+
+    // farthest from the plane v0 v1 v2
+    int base = acquire_face(v0, v1, v2);
+    int v3 = -1;
+    best = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double d = std::abs(distance(base, i));
+        if (d > best) { best = d; v3 = i; }
+    }
+    if (v3 < 0 || best <= eps_) return false;
+
+    // orient so that v3 lies below the base
+    if (distance(base, v3) > 0.0) {
+        std::swap(v1, v2);
+        release_face(base);
+        base = acquire_face(v0, v1, v2);
+    }
+    const int simplex[4] = {
+        base,
+        acquire_face(v1, v0, v3),
+        acquire_face(v2, v1, v3),
+        acquire_face(v0, v2, v3)
+    };
+
+    // link twins of the 12 half-edges
+    for (int f : simplex) {
+        for (int k = 0; k < 3; ++k) {
+            int e = 3 * f + k;
+            for (int g : simplex) {
+                if (g == f) continue;
+                for (int m = 0; m < 3; ++m) {
+                    int t = 3 * g + m;
+                    if (edge_origin_[t] == dest(e) && dest(t) == edge_origin_[e]) edge_twin_[e] = t;
+                }
+            }
+        }
+    }
+
+    // initial conflict lists
+    for (int i = 0; i < n; ++i) {
+        if (i == v0 || i == v1 || i == v2 || i == v3) continue;
+        int to = -1;
+        double far = eps_;
+        for (int f : simplex) {
+            double d = distance(f, i);
+            if (d > far) { far = d; to = f; }
+        }
+        if (to >= 0) add_conflict(to, i, far);
+    }
+    for (int f : simplex) {
+        if (!conflicts_[f].empty()) pending_.push_back(f);
+    }
+    return true;
+}
+
+void Quickhull3D::compute_horizon(int eye, int f) {
+    if (++stamp_ == 0) {
+        std::fill(visit_.begin(), visit_.end(), 0u);
+        stamp_ = 1;
+    }
+    visible_.clear();
+    horizon_.clear();
+    walk_.clear();
+
+    // depth first over visible faces, crossing each edge from its twin so the
+    // horizon edges come out as one CCW loop
+    visit_[f] = stamp_;
+    visible_.push_back(f);
+    walk_.push_back(HorizonStep{f, 3 * f, 0});
+    while (!walk_.empty()) {
+        HorizonStep& top = walk_.back();
+        if (top.k == 3) {
+            walk_.pop_back();
+            continue;
+        }
+        const int e = 3 * top.face + (top.start % 3 + top.k) % 3;
+        ++top.k;
+
+        const int t = edge_twin_[e];
+        const int g = t / 3;
+        if (visit_[g] == stamp_) continue;
+        if (distance(g, eye) > eps_) {
+            visit_[g] = stamp_;
+            visible_.push_back(g);
+            walk_.push_back(HorizonStep{g, next_edge(t), 0});
+        } else {
+            horizon_.push_back(e);
+        }
+    }
+}
+
+void Quickhull3D::add_cone(int eye) {
+    new_faces_.clear();
+    for (int e : horizon_) {
+        const int a = edge_origin_[e];
+        const int b = dest(e);
+        const int t = edge_twin_[e];
+        const int nf = acquire_face(a, b, eye);
+        edge_twin_[3 * nf] = t;
+        edge_twin_[t] = 3 * nf;
+        new_faces_.push_back(nf);
+    }
+
+    // side edges, face i goes a b eye and face i+1 starts at b
+    const int h = static_cast<int>(new_faces_.size());
+    for (int i = 0; i < h; ++i) {
+        const int cur = new_faces_[i];
+        const int nxt = new_faces_[(i + 1) % h];
+        edge_twin_[3 * cur + 1] = 3 * nxt + 2;
+        edge_twin_[3 * nxt + 2] = 3 * cur + 1;
+    }
+}
+
+void Quickhull3D::reassign_conflicts(int eye) {
+    for (int v : visible_) {
+        for (int p : conflicts_[v]) {
+            if (p == eye) continue;
+            int to = -1;
+            double far = eps_;
+            for (int nf : new_faces_) {
+                double d = distance(nf, p);
+                if (d > far) { far = d; to = nf; }
+            }
+            // points under every new face are inside the hull and drop out
+            if (to >= 0) add_conflict(to, p, far);
+        }
+    }
+}
+
+std::vector<core::Triangle> Quickhull3D::run_full() {
+    faces_.clear();
+    conflicts_.clear();
+    free_faces_.clear();
+    edge_origin_.clear();
+    edge_twin_.clear();
+    pending_.clear();
+    visit_.clear();
+    stamp_ = 0;
+
+    if (!build_initial_simplex()) {
+        faces_.clear();
+        return {};
+    }
+
+    while (!pending_.empty()) {
+        const int f = pending_.back();
+        pending_.pop_back();
+        // stale entries point at released or already drained slots
+        if (!faces_[f].alive || conflicts_[f].empty()) continue;
+
+        const int eye = faces_[f].far;
+        compute_horizon(eye, f);
+        add_cone(eye);
+        reassign_conflicts(eye);
+        for (int v : visible_) release_face(v);
+        for (int nf : new_faces_) {
+            if (!conflicts_[nf].empty()) pending_.push_back(nf);
+        }
+    }
+
+    std::vector<core::Triangle> tris;
+    tris.reserve(faces_.size() - free_faces_.size());
+    for (int f = 0; f < static_cast<int>(faces_.size()); ++f) {
+        if (!faces_[f].alive) continue;
+        tris.push_back(core::Triangle{edge_origin_[3 * f], edge_origin_[3 * f + 1], edge_origin_[3 * f + 2]});
+    }
+    return tris;
+}
+
+std::vector<int> Quickhull3D::vertices() const {
+    std::vector<int> out;
+    for (int f = 0; f < static_cast<int>(faces_.size()); ++f) {
+        if (!faces_[f].alive) continue;
+        out.push_back(edge_origin_[3 * f]);
+        out.push_back(edge_origin_[3 * f + 1]);
+        out.push_back(edge_origin_[3 * f + 2]);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+void Quickhull3D::report(long long ns, int face_count) const {
+    std::cout << name() << ": " << ns << "ns," << " hull faces: " << face_count
+              << ", hull vertices: " << vertices().size() << std::endl;
+}
@@ -0,0 +1,79 @@
+#ifndef ALGORITHMS_QUICKHULL3D_H
+#define ALGORITHMS_QUICKHULL3D_H
+
+#include "core/types.h"
+#include <vector>
+
+// 3d quickhull on a triangle half-edge mesh with per-face conflict lists.
+// faces live in a pool, the three half-edges of face f are 3f, 3f+1, 3f+2,
+// so releasing a face also releases its edges and its conflict list storage.
+class Quickhull3D final {
+public:
+    Quickhull3D() = default;
+
+    const char* name() const { return "Quickhull3D"; }
+
+    // set input points. indices in all outputs refer to this array
+    void reset(const std::vector<core::Point3>& pts);
+
+    // compute full hull. return outward facing triangles, empty for flat or tiny input
+    std::vector<core::Triangle> run_full();
+
+    // hull vertex indices of the last run_full, sorted ascending
+    std::vector<int> vertices() const;
+
+    void report(long long ns, int face_count) const;
+
+private:
+    struct Face {
+        double nx{}, ny{}, nz{}, d{}; // unit normal and offset, dist = n.p - d
+        int far{-1};                  // farthest conflict point
+        double far_dist{0.0};
+        bool alive{false};
+    };
+
+    struct HorizonStep {
+        int face;
+        int start;  // first edge to walk
+        int k;      // edges walked so far
+    };
+
+    std::vector<core::Point3> points_;
+    double eps_{0.0};
+
+    // face pool, conflicts_[f] and edges 3f..3f+2 belong to face slot f
+    std::vector<Face> faces_;
+    std::vector<std::vector<int>> conflicts_;
+    std::vector<int> free_faces_;
+    std::vector<int> edge_origin_;
+    std::vector<int> edge_twin_;
+
+    // scratch reused between iterations
+    std::vector<int> pending_;
+    std::vector<int> visible_;
+    std::vector<int> horizon_;
+    std::vector<int> new_faces_;
+    std::vector<HorizonStep> walk_;
+    std::vector<unsigned> visit_;
+    unsigned stamp_{0};
+
+    static int next_edge(int e) { return e - e % 3 + (e % 3 + 1) % 3; }
+    int dest(int e) const { return edge_origin_[next_edge(e)]; }
+
+    double distance(int f, int p) const {
+        const Face& fc = faces_[f];
+        const core::Point3& q = points_[p];
+        return fc.nx * q.x + fc.ny * q.y + fc.nz * q.z - fc.d;
+    }
+
+    int acquire_face(int a, int b, int c);
+    void release_face(int f);
+    void add_conflict(int f, int p, double dist);
+
+    bool build_initial_simplex();
+    void compute_horizon(int eye, int f);
+    void add_cone(int eye);
+    void reassign_conflicts(int eye);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "algorithms/sliding_window_hull.h"
+#include "core/geometry.h"
+#include <algorithm>
+#include <stdexcept>
+
+using core::Point;
+
+namespace {
+    bool less_xy(const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    // Andrew's chain over points already in x then y order, sign 1 keeps
+    // left turns, -1 right turns. the two parts can share a position
+    std::vector<Point> chain_of(const std::vector<Point>& sorted, double sign) {
+        std::vector<Point> out;
+        out.reserve(sorted.size());
+        for (const Point& p : sorted) {
+            if (!out.empty() && core::same_position(out.back(), p)) continue;
+            while (out.size() >= 2 && sign * core::orient(out[out.size() - 2], out.back(), p) <= 0.0) out.pop_back();
+            out.push_back(p);
+        }
+        return out;
+    }
+
+    std::vector<Point> merged_chain(const std::vector<Point>& a, const std::vector<Point>& b, double sign) {
+        std::vector<Point> sorted(a.size() + b.size());
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), sorted.begin(), less_xy);
+        return chain_of(sorted, sign);
+    }
+}
+
+SlidingWindowHull::Chain::Edit SlidingWindowHull::Chain::insert(const Point& p, bool undoable) {
+    const int n = static_cast<int>(pts_.size());
+    const int pos = static_cast<int>(std::lower_bound(pts_.begin(), pts_.end(), p, less_xy) - pts_.begin());
+    if (pos < n && core::same_position(pts_[pos], p)) return {};
+    // on the far side of the edge it falls under, or on it
+    if (pos > 0 && pos < n && sign_ * core::orient(pts_[pos - 1], p, pts_[pos]) <= 0.0) return {};
+
+    // neighbours p makes non convex, on both sides
+    int l = pos;
+    while (l >= 2 && sign_ * core::orient(pts_[l - 2], pts_[l - 1], p) <= 0.0) --l;
+    int r = pos;
+    while (r + 1 < n && sign_ * core::orient(p, pts_[r], pts_[r + 1]) <= 0.0) ++r;
+
+    if (undoable) stash_.insert(stash_.end(), pts_.begin() + l, pts_.begin() + r);
+    if (r > l) {
+        pts_[l] = p;
+        pts_.erase(pts_.begin() + l + 1, pts_.begin() + r);
+    } else {
+        pts_.insert(pts_.begin() + l, p);
+    }
+    return {l, r - l};
+}
+
+void SlidingWindowHull::Chain::undo(const Edit& e) {
+    if (e.pos < 0) return;
+    const auto kept = stash_.end() - e.removed;
+    if (e.removed == 0) {
+        pts_.erase(pts_.begin() + e.pos);
+    } else {
+        pts_[e.pos] = *kept;
+        pts_.insert(pts_.begin() + e.pos + 1, kept + 1, stash_.end());
+    }
+    stash_.erase(kept, stash_.end());
+}
+
+void SlidingWindowHull::Chain::clear() {
+    pts_.clear();
+    stash_.clear();
+}
+
+SlidingWindowHull::SlidingWindowHull(std::size_t max_points, double max_age)
+    : max_points_(max_points), max_age_(max_age) {
+    if (max_points_ == 0) throw std::runtime_error("sliding window needs room for at least one point");
+}
+
+void SlidingWindowHull::push(const Point& p, double time) {
+    window_.push_back({p, time});
+    back_lower_.insert(p, false);
+    back_upper_.insert(p, false);
+    while (window_.size() > max_points_) pop_front();
+    expire(time);
+}
+
+void SlidingWindowHull::pop_front() {
+    if (window_.empty()) return;
+    if (front_count_ == 0) move_back_to_front();
+    const Change& c = front_log_.back();
+    front_lower_.undo(c.lower);
+    front_upper_.undo(c.upper);
+    front_log_.pop_back();
+    window_.pop_front();
+    --front_count_;
+}
+
+void SlidingWindowHull::expire(double now) {
+    while (!window_.empty() && now - window_.front().time > max_age_) pop_front();
+}
+
+void SlidingWindowHull::move_back_to_front() {
+    // the front chains are empty here, every insert into them has been undone
+    back_lower_.clear();
+    back_upper_.clear();
+    front_log_.reserve(window_.size());
+    for (auto it = window_.rbegin(); it != window_.rend(); ++it) {
+        front_log_.push_back({front_lower_.insert(it->p, true), front_upper_.insert(it->p, true)});
+    }
+    front_count_ = window_.size();
+}
+
+std::vector<Point> SlidingWindowHull::hull() const {
+    std::vector<Point> lower = merged_chain(front_lower_.points(), back_lower_.points(), 1.0);
+    if (lower.size() <= 1) return lower;
+    std::vector<Point> upper = merged_chain(front_upper_.points(), back_upper_.points(), -1.0);
+
+    // lower from the left end to the right, then upper back without its ends
+    std::vector<Point> out(lower);
+    for (std::size_t k = upper.size() - 1; k-- > 1;) out.push_back(upper[k]);
+    return out;
+}
@@ -0,0 +1,96 @@
+#ifndef ALGORITHMS_SLIDING_WINDOW_HULL_H
+#define ALGORITHMS_SLIDING_WINDOW_HULL_H
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <vector>
+#include "core/types.h"
+
+// hull of the last max_points points of a stream, or of those no older than
+// max_age, kept up to date on every push.
+//
+// the window is a queue made of two stacks. the back part keeps Andrew's
+// lower and upper chains of its points and takes each new point by local
+// insertion. the front part holds chains built from its newest point to its
+// oldest with an undo record per point, so dropping the oldest point is
+// undoing the last insertion. when the front runs empty the back moves over
+// in one rebuild. every point is inserted and undone once per pass, so
+// push and pop are amortized O(log h) plus the chain edits, and hull() merges
+// the two parts' chains in O(h)
+class SlidingWindowHull {
+public:
+    explicit SlidingWindowHull(std::size_t max_points,
+                               double max_age = std::numeric_limits<double>::infinity());
+
+    // appends p, then drops points beyond max_points or older than max_age
+    // relative to time. times are expected not to decrease
+    void push(const core::Point& p, double time = 0.0);
+
+    // drops the oldest point, if any
+    void pop_front();
+
+    // drops the points older than max_age relative to now
+    void expire(double now);
+
+    std::size_t size() const { return window_.size(); }
+    bool empty() const { return window_.empty(); }
+
+    // the window's hull, CCW from the lowest x, ids as pushed
+    std::vector<core::Point> hull() const;
+
+private:
+    struct Entry {
+        core::Point p;
+        double time;
+    };
+
+    // one monotone chain in x then y order. the lower chain turns left at
+    // every vertex, the upper chain right
+    class Chain {
+    public:
+        // where an insert put p and how many vertices it replaced, pos is
+        // -1 when p is not on the chain and nothing changed
+        struct Edit {
+            int pos{-1};
+            int removed{0};
+        };
+
+        explicit Chain(double sign) : sign_(sign) {}
+
+        // undoable inserts keep the vertices they remove
+        Edit insert(const core::Point& p, bool undoable);
+        // reverts the latest undoable insert
+        void undo(const Edit& e);
+        void clear();
+
+        const std::vector<core::Point>& points() const { return pts_; }
+
+    private:
+        double sign_;
+        std::vector<core::Point> pts_;
+        std::vector<core::Point> stash_;
+    };
+
+    // undo record of one front point
+    struct Change {
+        Chain::Edit lower;
+        Chain::Edit upper;
+    };
+
+    std::size_t max_points_;
+    double max_age_;
+
+    std::deque<Entry> window_;
+    std::size_t front_count_{0};      // oldest entries held by the front chains
+
+    Chain front_lower_{1.0};
+    Chain front_upper_{-1.0};
+    std::vector<Change> front_log_;   // newest front point first, oldest on top
+    Chain back_lower_{1.0};
+    Chain back_upper_{-1.0};
+
+    void move_back_to_front();
+};
+
+#endif
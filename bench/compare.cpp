@@ -0,0 +1,161 @@
+#include "bench/compare.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+
+namespace bench {
+    // continued fraction of the regularized incomplete beta function,
+    // modified Lentz
+    static double beta_fraction(double a, double b, double x) {
+        constexpr double kTiny = 1e-300;
+        constexpr double kEps = 1e-14;
+        const double qab = a + b;
+        const double qap = a + 1.0;
+        const double qam = a - 1.0;
+        double c = 1.0;
+        double d = 1.0 - qab * x / qap;
+        if (std::fabs(d) < kTiny) d = kTiny;
+        d = 1.0 / d;
+        double h = d;
+        for (int m = 1; m <= 300; ++m) {
+            const double m2 = 2.0 * m;
+            double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < kTiny) d = kTiny;
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < kTiny) c = kTiny;
+            d = 1.0 / d;
+            h *= d * c;
+            aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < kTiny) d = kTiny;
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < kTiny) c = kTiny;
+            d = 1.0 / d;
+            const double step = d * c;
+            h *= step;
+            if (std::fabs(step - 1.0) < kEps) break;
+        }
+        return h;
+    }
+
+    static double incomplete_beta(double a, double b, double x) {
+        if (x <= 0.0) return 0.0;
+        if (x >= 1.0) return 1.0;
+        const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                      a * std::log(x) + b * std::log1p(-x));
+        if (x < (a + 1.0) / (a + b + 2.0)) return front * beta_fraction(a, b, x) / a;
+        return 1.0 - front * beta_fraction(b, a, 1.0 - x) / b;
+    }
+
+    static void mean_var(const std::vector<double>& v, double& mean, double& var) {
+        mean = 0.0;
+        for (double x : v) mean += x;
+        mean /= static_cast<double>(v.size());
+        var = 0.0;
+        for (double x : v) var += (x - mean) * (x - mean);
+        var /= static_cast<double>(v.size() - 1);
+    }
+
+    WelchResult welch_t_test(const std::vector<double>& a, const std::vector<double>& b) {
+        WelchResult r;
+        if (a.size() < 2 || b.size() < 2) return r;
+        double ma, va, mb, vb;
+        mean_var(a, ma, va);
+        mean_var(b, mb, vb);
+        const double sa = va / static_cast<double>(a.size());
+        const double sb = vb / static_cast<double>(b.size());
+        const double se2 = sa + sb;
+        if (se2 <= 0.0) {
+            // no spread on either side, any difference is certain
+            r.p = ma == mb ? 1.0 : 0.0;
+            return r;
+        }
+        r.t = (ma - mb) / std::sqrt(se2);
+        r.df = se2 * se2 / (sa * sa / static_cast<double>(a.size() - 1) + sb * sb / static_cast<double>(b.size() - 1));
+        // two sided tail of Student's t
+        r.p = incomplete_beta(r.df / 2.0, 0.5, r.df / (r.df + r.t * r.t));
+        return r;
+    }
+
+    static double mean_of(const std::vector<double>& v) {
+        double sum = 0.0;
+        for (double x : v) sum += x;
+        return v.empty() ? 0.0 : sum / static_cast<double>(v.size());
+    }
+
+    std::vector<Comparison> compare(const std::vector<Sample>& base, const std::vector<Sample>& current,
+                                    const CompareOptions& opt) {
+        using Key = std::tuple<std::string, std::string, std::size_t>;
+        std::map<Key, std::pair<std::vector<double>, std::vector<double>>> runs;
+        for (const Sample& s : base) runs[{s.algorithm, s.generator, s.n}].first.push_back(static_cast<double>(s.ns));
+        for (const Sample& s : current) runs[{s.algorithm, s.generator, s.n}].second.push_back(static_cast<double>(s.ns));
+
+        std::vector<Comparison> rows;
+        rows.reserve(runs.size());
+        for (const auto& [key, sides] : runs) {
+            const auto& [b, c] = sides;
+            Comparison row;
+            std::tie(row.algorithm, row.generator, row.n) = key;
+            row.base_runs = b.size();
+            row.new_runs = c.size();
+            row.base_mean = mean_of(b);
+            row.new_mean = mean_of(c);
+            row.tested = b.size() >= 2 && c.size() >= 2;
+            if (row.tested) {
+                row.p = welch_t_test(b, c).p;
+                row.significant = row.p < opt.alpha;
+                row.regression = row.significant && row.new_mean > row.base_mean * (1.0 + opt.threshold);
+            }
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    static std::string fixed(double v, int digits) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(digits) << v;
+        return s.str();
+    }
+
+    void print_table(std::ostream& out, const std::vector<Comparison>& rows, const CompareOptions& opt) {
+        std::size_t algo_w = 9;
+        std::size_t gen_w = 9;
+        for (const Comparison& r : rows) {
+            algo_w = std::max(algo_w, r.algorithm.size());
+            gen_w = std::max(gen_w, r.generator.size());
+        }
+        out << std::left << std::setw(static_cast<int>(algo_w)) << "algorithm" << "  "
+            << std::setw(static_cast<int>(gen_w)) << "generator" << "  " << std::right
+            << std::setw(10) << "n" << std::setw(13) << "base ms" << std::setw(13) << "new ms"
+            << std::setw(10) << "speedup" << std::setw(9) << "p" << "  verdict\n";
+        for (const Comparison& r : rows) {
+            std::string verdict;
+            std::string speedup = "-";
+            std::string p = "-";
+            if (r.base_runs == 0) {
+                verdict = "new";
+            } else if (r.new_runs == 0) {
+                verdict = "missing";
+            } else {
+                speedup = fixed(r.base_mean / std::max(1.0, r.new_mean), 2) + "x";
+                if (!r.tested) verdict = "needs 2+ runs per side";
+                else if (r.regression) verdict = "REGRESSION";
+                else if (!r.significant) verdict = "no change";
+                else verdict = r.new_mean < r.base_mean ? "faster" : "slower, within threshold";
+                if (r.tested) p = fixed(r.p, 3);
+            }
+            out << std::left << std::setw(static_cast<int>(algo_w)) << r.algorithm << "  "
+                << std::setw(static_cast<int>(gen_w)) << r.generator << "  " << std::right
+                << std::setw(10) << r.n
+                << std::setw(13) << (r.base_runs ? fixed(r.base_mean / 1e6, 3) : "-")
+                << std::setw(13) << (r.new_runs ? fixed(r.new_mean / 1e6, 3) : "-")
+                << std::setw(10) << speedup << std::setw(9) << p << "  " << verdict << "\n";
+        }
+        out << "alpha " << opt.alpha << ", regression past " << fixed(opt.threshold * 100.0, 1) << "% slower\n";
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef BENCH_COMPARE_H
+#define BENCH_COMPARE_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "bench/results.h"
+
+namespace bench {
+    struct WelchResult {
+        double t{0.0};
+        double df{0.0};
+        double p{1.0};   // two sided
+    };
+
+    // Welch's t test for a difference in means without assuming equal
+    // variances. both sides need two samples or more
+    WelchResult welch_t_test(const std::vector<double>& a, const std::vector<double>& b);
+
+    struct CompareOptions {
+        double alpha{0.05};       // significance level
+        double threshold{0.05};   // slowdown ratio above which a significant change fails
+    };
+
+    // one (algorithm, generator, n) across both files
+    struct Comparison {
+        std::string algorithm;
+        std::string generator;
+        std::size_t n{0};
+        std::size_t base_runs{0};
+        std::size_t new_runs{0};
+        double base_mean{0.0};    // ns
+        double new_mean{0.0};
+        double p{1.0};
+        bool tested{false};       // both sides had enough runs for the t test
+        bool significant{false};
+        bool regression{false};   // significant and slower by more than the threshold
+    };
+
+    // rows sorted by algorithm, generator and n. keys present on one side
+    // only get a row with zero runs on the other
+    std::vector<Comparison> compare(const std::vector<Sample>& base, const std::vector<Sample>& current,
+                                    const CompareOptions& opt);
+
+    void print_table(std::ostream& out, const std::vector<Comparison>& rows, const CompareOptions& opt);
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "bench/results.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace bench {
+    std::string machine_name() {
+        char host[256]{};
+        if (::gethostname(host, sizeof(host) - 1) != 0) return "unknown";
+        std::string name(host);
+        for (char& c : name) {
+            const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                              c == '.' || c == '-' || c == '_';
+            if (!safe) c = '_';
+        }
+        return name.empty() ? "unknown" : name;
+    }
+
+    std::string results_dir(const std::string& machine) {
+        return "bench_results/" + machine;
+    }
+
+    std::string baseline_path(const std::string& machine) {
+        return results_dir(machine) + "/baseline.csv";
+    }
+
+    std::string latest_path(const std::string& machine) {
+        return results_dir(machine) + "/latest.csv";
+    }
+
+    static std::string csv_field(std::string s) {
+        std::replace(s.begin(), s.end(), ',', ';');
+        return s;
+    }
+
+    void write_results(const std::string& path, const std::vector<Sample>& samples) {
+        const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) throw std::runtime_error("cannot create results file " + path);
+        out << "# machine " << machine_name() << "\n";
+        out << "algorithm,generator,n,ns\n";
+        for (const Sample& s : samples) {
+            out << csv_field(s.algorithm) << ',' << csv_field(s.generator) << ',' << s.n << ',' << s.ns << '\n';
+        }
+        if (!out) throw std::runtime_error("cannot write results file " + path);
+    }
+
+    std::vector<Sample> read_results(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot open results file " + path);
+        std::vector<Sample> samples;
+        std::string line;
+        int line_no = 0;
+        while (std::getline(in, line)) {
+            ++line_no;
+            if (line.empty() || line[0] == '#' || line.rfind("algorithm,", 0) == 0) continue;
+            std::istringstream row(line);
+            Sample s;
+            std::string n;
+            std::string ns;
+            if (!std::getline(row, s.algorithm, ',') || !std::getline(row, s.generator, ',') ||
+                !std::getline(row, n, ',') || !std::getline(row, ns)) {
+                throw std::runtime_error("bad row " + std::to_string(line_no) + " in " + path);
+            }
+            try {
+                s.n = static_cast<std::size_t>(std::stoull(n));
+                s.ns = std::stoll(ns);
+            } catch (const std::exception&) {
+                throw std::runtime_error("bad number in row " + std::to_string(line_no) + " of " + path);
+            }
+            samples.push_back(std::move(s));
+        }
+        return samples;
+    }
+}
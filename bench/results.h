@@ -0,0 +1,32 @@
+#ifndef BENCH_RESULTS_H
+#define BENCH_RESULTS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// benchmark result files, one csv row per timed run:
+//   algorithm,generator,n,ns
+// lines starting with # are comments. results are kept per machine under
+// bench_results/<machine>/, baseline.csv next to latest.csv
+namespace bench {
+    struct Sample {
+        std::string algorithm;
+        std::string generator;
+        std::size_t n{0};
+        long long ns{0};
+    };
+
+    // host name reduced to characters safe in a path
+    std::string machine_name();
+
+    std::string results_dir(const std::string& machine);
+    std::string baseline_path(const std::string& machine);
+    std::string latest_path(const std::string& machine);
+
+    // creates missing directories. commas in names become semicolons
+    void write_results(const std::string& path, const std::vector<Sample>& samples);
+    std::vector<Sample> read_results(const std::string& path);
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CORE_CHECKS_H
+#define CORE_CHECKS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace core {
+    // points, keys, ids or comparisons between two looks at a stop request,
+    // well under a millisecond of work for any loop here
+    inline constexpr std::size_t kCheckEvery = std::size_t{1} << 16;
+
+    // how a long loop looks at a stop request. both are empty for a plain
+    // run, which then takes every loop in one piece
+    struct Checks {
+        // for parallel_chunks workers, which must not throw. they stop early
+        // and the caller checkpoints after the join
+        std::function<bool()> stop_fn;
+        // throws once stop was requested, reports progress otherwise
+        std::function<void(const char* phase, std::size_t done, std::size_t total)> checkpoint_fn;
+
+        explicit operator bool() const { return static_cast<bool>(checkpoint_fn); }
+
+        bool stop_requested() const { return stop_fn && stop_fn(); }
+
+        void checkpoint(const char* phase, std::size_t done, std::size_t total) const {
+            if (checkpoint_fn) checkpoint_fn(phase, done, total);
+        }
+    };
+
+    // fn(begin, end) over [0, n), in slices of kCheckEvery with a checkpoint
+    // after each when checks has one
+    template <class Fn>
+    void sliced(const Checks& checks, const char* phase, std::size_t n, Fn&& fn) {
+        if (!checks) {
+            fn(std::size_t{0}, n);
+            return;
+        }
+        for (std::size_t begin = 0; begin < n; begin += kCheckEvery) {
+            const std::size_t end = std::min(n, begin + kCheckEvery);
+            fn(begin, end);
+            checks.checkpoint(phase, end, n);
+        }
+    }
+}
+
+#endif
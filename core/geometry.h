@@ -0,0 +1,34 @@
+#ifndef CORE_GEOMETRY_H
+#define CORE_GEOMETRY_H
+
+#include <cmath>
+#include "core/types.h"
+
+namespace core {
+    // twice the signed area of abc, positive for a left turn. the inputs are
+    // floats, so for coordinates of similar magnitude the differences and
+    // products are exact in double and only the final subtraction rounds
+    inline double orient(const Point& a, const Point& b, const Point& c) {
+        const double abx = static_cast<double>(b.x) - a.x;
+        const double aby = static_cast<double>(b.y) - a.y;
+        const double acx = static_cast<double>(c.x) - a.x;
+        const double acy = static_cast<double>(c.y) - a.y;
+        return abx * acy - aby * acx;
+    }
+
+    inline double dist2(const Point& a, const Point& b) {
+        const double dx = static_cast<double>(b.x) - a.x;
+        const double dy = static_cast<double>(b.y) - a.y;
+        return dx * dx + dy * dy;
+    }
+
+    inline double dist(const Point& a, const Point& b) {
+        return std::sqrt(dist2(a, b));
+    }
+
+    inline bool same_position(const Point& a, const Point& b) {
+        return a.x == b.x && a.y == b.y;
+    }
+}
+
+#endif
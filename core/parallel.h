@@ -0,0 +1,41 @@
+#ifndef CORE_PARALLEL_H
+#define CORE_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace core {
+    inline unsigned worker_count() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    // split [0, n) into one contiguous chunk per worker and run
+    // fn(begin, end, worker) on each. small inputs run on the caller's thread
+    template <class Fn>
+    void parallel_chunks(std::size_t n, Fn&& fn, std::size_t min_chunk = 1u << 15) {
+        std::size_t workers = std::min<std::size_t>(worker_count(), (n + min_chunk - 1) / min_chunk);
+        if (workers <= 1) {
+            fn(std::size_t{0}, n, 0u);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t w = 1; w < workers; ++w) {
+            threads.emplace_back([&fn, n, w, workers] {
+                fn(n * w / workers, n * (w + 1) / workers, static_cast<unsigned>(w));
+            });
+        }
+        fn(std::size_t{0}, n / workers, 0u);
+        for (std::thread& t : threads) t.join();
+    }
+
+    // number of chunks parallel_chunks will use for n items
+    inline std::size_t chunk_count(std::size_t n, std::size_t min_chunk = 1u << 15) {
+        return std::max<std::size_t>(1, std::min<std::size_t>(worker_count(), (n + min_chunk - 1) / min_chunk));
+    }
+}
+
+#endif
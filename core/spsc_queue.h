@@ -0,0 +1,69 @@
+#ifndef CORE_SPSC_QUEUE_H
+#define CORE_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace core {
+    // bounded lock free queue for exactly one producer and one consumer
+    // thread. head and tail live on their own cache lines and each side keeps
+    // a cached copy of the other index so the shared one is only read when
+    // the queue looks full or empty
+    template <class T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(std::size_t capacity) {
+            std::size_t cap = 2;
+            while (cap < capacity) cap <<= 1;
+            slots_.resize(cap);
+            mask_ = cap - 1;
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // producer side, false when full
+        bool try_push(T&& value) {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cached_ > mask_) {
+                head_cached_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cached_ > mask_) return false;
+            }
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side, false when empty
+        bool try_pop(T& out) {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cached_) {
+                tail_cached_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cached_) return false;
+            }
+            out = std::move(slots_[head & mask_]);
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // approximate when called from a third thread
+        bool empty() const {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        std::size_t capacity() const { return slots_.size(); }
+
+    private:
+        std::vector<T> slots_;
+        std::size_t mask_{0};
+
+        alignas(64) std::atomic<std::size_t> head_{0}; // written by the consumer
+        std::size_t tail_cached_{0};                   // consumer's view of tail_
+        alignas(64) std::atomic<std::size_t> tail_{0}; // written by the producer
+        std::size_t head_cached_{0};                   // producer's view of head_
+    };
+}
+
+#endif
@@ -11,6 +11,20 @@ namespace core {
         int id{};
     };
 
+    struct Point3 {
+        float x{};
+        float y{};
+        float z{};
+        int id{};
+    };
+
+    // triangle of a 3d hull, indices into the input array, CCW seen from outside
+    struct Triangle {
+        int a{-1};
+        int b{-1};
+        int c{-1};
+    };
+
     enum class StepKind {
         Start,
         PickPivot,
@@ -0,0 +1,253 @@
+#include "distributed/sharded_hull.h"
+#include "distributed/wire.h"
+#include "io/point_file.h"
+#include "core/stopwatch.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace distributed {
+    using SteadyClock = std::chrono::steady_clock;
+
+    ShardedHull::ShardedHull(AlgoFactory make, int workers)
+        : make_(std::move(make)), workers_(workers < 1 ? 1 : workers) {
+        if (!make_) throw std::runtime_error("sharded hull needs an algorithm");
+    }
+
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now().time_since_epoch()).count();
+    }
+
+    // the vertices of a message, after checking the payload holds count of them
+    static std::vector<WireVertex> payload_vertices(const MessageHeader& header, const std::vector<char>& payload) {
+        const auto n = static_cast<std::size_t>(header.count);
+        if (header.count > payload.size() / sizeof(WireVertex)) {
+            throw std::runtime_error("payload of " + std::to_string(payload.size()) + " bytes is short of " +
+                                     std::to_string(header.count) + " vertices");
+        }
+        std::vector<WireVertex> verts(n);
+        std::memcpy(verts.data(), payload.data(), n * sizeof(WireVertex));
+        return verts;
+    }
+
+    // closing the socket ends the worker loop, then wait for the process
+    void ShardedHull::reap(std::vector<Worker>& workers) {
+        for (Worker& w : workers) {
+            if (w.fd >= 0) ::close(w.fd);
+            w.fd = -1;
+        }
+        for (Worker& w : workers) {
+            if (w.pid > 0) ::waitpid(w.pid, nullptr, 0);
+            w.pid = -1;
+        }
+    }
+
+    std::vector<ShardedHull::Worker> ShardedHull::spawn() const {
+        std::vector<Worker> out;
+        out.reserve(workers_);
+        for (int i = 0; i < workers_; ++i) {
+            int sv[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+                throw std::runtime_error(std::string("socketpair failed: ") + std::strerror(errno));
+            }
+            const int pid = ::fork();
+            if (pid < 0) {
+                ::close(sv[0]);
+                ::close(sv[1]);
+                throw std::runtime_error(std::string("fork failed: ") + std::strerror(errno));
+            }
+            if (pid == 0) {
+                // the child only keeps its own end
+                ::close(sv[0]);
+                for (const Worker& w : out) ::close(w.fd);
+                // never unwind back into the coordinator's stack from the child
+                try {
+                    worker_main(sv[1], make_);
+                } catch (...) {
+                    ::_exit(1);
+                }
+                ::_exit(0);
+            }
+            ::close(sv[1]);
+            out.push_back(Worker{pid, sv[0]});
+        }
+        return out;
+    }
+
+    void ShardedHull::worker_main(int fd, const AlgoFactory& make) {
+        MessageHeader req{};
+        std::vector<char> payload;
+        Stopwatch sw;
+        while (recv_header(fd, req)) {
+            try {
+                sw.start();
+                if (!recv_payload(fd, req, payload)) return;
+
+                std::vector<core::Point> pts;
+                if (req.kind == MessageKind::InlinePoints) {
+                    pts = from_wire(payload_vertices(req, payload));
+                } else if (req.kind == MessageKind::FileRange) {
+                    // ids are the int point ids, the coordinator refuses larger files
+                    if (req.first + req.count > static_cast<std::uint64_t>(INT_MAX) + 1) {
+                        throw std::runtime_error("file range past the int id space");
+                    }
+                    io::PointFileReader reader(std::string(payload.begin(), payload.end()));
+                    const auto n = static_cast<std::size_t>(req.count);
+                    std::vector<float> xs(n);
+                    std::vector<float> ys(n);
+                    reader.read_block(req.first, n, xs.data(), ys.data());
+                    pts.resize(n);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        pts[i] = core::Point{xs[i], ys[i], static_cast<int>(req.first + i)};
+                    }
+                } else {
+                    throw std::runtime_error("unexpected request kind");
+                }
+                sw.stop();
+                const long long read_ns = sw.ns();
+
+                std::unique_ptr<ConvexHullAlgorithm> algo = make();
+                sw.start();
+                algo->reset(pts);
+                std::vector<int> ids = algo->run_full();
+                sw.stop();
+
+                std::vector<WireVertex> hull;
+                hull.reserve(ids.size());
+                for (int id : ids) hull.push_back(WireVertex{pts[id].x, pts[id].y, pts[id].id});
+
+                MessageHeader rep{};
+                rep.kind = MessageKind::Hull;
+                rep.shard = req.shard;
+                rep.count = hull.size();
+                rep.payload_bytes = hull.size() * sizeof(WireVertex);
+                rep.read_ns = read_ns;
+                rep.hull_ns = sw.ns();
+                send_message(fd, rep, hull.data());
+            } catch (const std::exception& e) {
+                MessageHeader rep{};
+                rep.kind = MessageKind::Error;
+                rep.shard = req.shard;
+                rep.payload_bytes = std::strlen(e.what());
+                send_message(fd, rep, e.what());
+            }
+        }
+    }
+
+    ShardedHullResult ShardedHull::collect(std::vector<Worker>& workers, std::vector<ShardStats>& stats) const {
+        ShardedHullResult res;
+        std::vector<core::Point> cand;
+        std::vector<char> payload;
+
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            MessageHeader rep{};
+            if (!recv_header(workers[i].fd, rep) || !recv_payload(workers[i].fd, rep, payload)) {
+                throw std::runtime_error("worker " + std::to_string(i) + " closed its socket");
+            }
+            if (rep.kind == MessageKind::Error) {
+                throw std::runtime_error("worker " + std::to_string(i) + ": " + std::string(payload.begin(), payload.end()));
+            }
+            if (rep.kind != MessageKind::Hull) throw std::runtime_error("unexpected reply kind");
+
+            std::vector<core::Point> local = from_wire(payload_vertices(rep, payload));
+
+            ShardStats& st = stats[i];
+            st.hull_size = local.size();
+            st.read_ns = rep.read_ns;
+            st.hull_ns = rep.hull_ns;
+            st.bytes_in = sizeof(MessageHeader) + payload.size();
+            st.round_trip_ns = now_ns() - st.round_trip_ns; // held the send timestamp until now
+            cand.insert(cand.end(), local.begin(), local.end());
+        }
+
+        // merge only the shard hulls, positions map back to global ids
+        Stopwatch sw;
+        sw.start();
+        std::vector<int> global(cand.size());
+        for (std::size_t i = 0; i < cand.size(); ++i) {
+            global[i] = cand[i].id;
+            cand[i].id = static_cast<int>(i);
+        }
+        std::unique_ptr<ConvexHullAlgorithm> merger = make_();
+        merger->reset(cand);
+        std::vector<int> ids = merger->run_full();
+        res.hull.reserve(ids.size());
+        for (int id : ids) res.hull.push_back(core::Point{cand[id].x, cand[id].y, global[id]});
+        sw.stop();
+        res.merge_ns = sw.ns();
+
+        res.shards = stats;
+        return res;
+    }
+
+    ShardedHullResult ShardedHull::dispatch(const ShardSender& send_shard) const {
+        Stopwatch total;
+        total.start();
+        std::vector<Worker> workers = spawn();
+
+        std::vector<ShardStats> stats(workers.size());
+        ShardedHullResult res;
+        try {
+            for (std::size_t i = 0; i < workers.size(); ++i) {
+                stats[i].shard = static_cast<int>(i);
+                stats[i].round_trip_ns = now_ns();
+                send_shard(workers[i].fd, i, workers.size(), stats[i]);
+            }
+            res = collect(workers, stats);
+        } catch (...) {
+            reap(workers);
+            throw;
+        }
+        reap(workers);
+        total.stop();
+        res.total_ns = total.ns();
+        return res;
+    }
+
+    ShardedHullResult ShardedHull::run(const std::vector<core::Point>& pts) {
+        return dispatch([&](int fd, std::size_t i, std::size_t shards, ShardStats& st) {
+            const std::size_t lo = pts.size() * i / shards;
+            const std::size_t hi = pts.size() * (i + 1) / shards;
+            std::vector<WireVertex> verts = to_wire(std::vector<core::Point>(pts.begin() + lo, pts.begin() + hi));
+
+            MessageHeader req{};
+            req.kind = MessageKind::InlinePoints;
+            req.shard = static_cast<std::uint32_t>(i);
+            req.first = lo;
+            req.count = verts.size();
+            req.payload_bytes = verts.size() * sizeof(WireVertex);
+
+            st.points = verts.size();
+            st.bytes_out = sizeof(req) + req.payload_bytes;
+            send_message(fd, req, verts.data());
+        });
+    }
+
+    ShardedHullResult ShardedHull::run(const std::string& point_file) {
+        const std::uint64_t n = io::PointFileReader(point_file).count();
+        // point and wire ids are int, so positions past INT_MAX have no id
+        if (n > static_cast<std::uint64_t>(INT_MAX) + 1) {
+            throw std::runtime_error(point_file + " has " + std::to_string(n) + " points, more than int ids can address");
+        }
+        return dispatch([&](int fd, std::size_t i, std::size_t shards, ShardStats& st) {
+            const std::uint64_t lo = n * i / shards;
+            const std::uint64_t hi = n * (i + 1) / shards;
+
+            MessageHeader req{};
+            req.kind = MessageKind::FileRange;
+            req.shard = static_cast<std::uint32_t>(i);
+            req.first = lo;
+            req.count = hi - lo;
+            req.payload_bytes = point_file.size();
+
+            st.points = hi - lo;
+            st.bytes_out = sizeof(req) + req.payload_bytes;
+            send_message(fd, req, point_file.data());
+        });
+    }
+}
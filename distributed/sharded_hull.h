@@ -0,0 +1,68 @@
+#ifndef DISTRIBUTED_SHARDED_HULL_H
+#define DISTRIBUTED_SHARDED_HULL_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+
+namespace distributed {
+    struct ShardStats {
+        int shard{0};
+        std::uint64_t points{0};
+        std::size_t hull_size{0};
+        long long read_ns{0};       // worker side, receiving or reading its shard
+        long long hull_ns{0};       // worker side, run_full
+        long long round_trip_ns{0}; // coordinator side, shard sent until hull received
+        std::size_t bytes_out{0};   // coordinator to worker
+        std::size_t bytes_in{0};    // worker to coordinator
+    };
+
+    struct ShardedHullResult {
+        std::vector<core::Point> hull; // CCW, ids are global point ids
+        std::vector<ShardStats> shards;
+        long long merge_ns{0};
+        long long total_ns{0};
+    };
+
+    // coordinator for a hull over forked local worker processes. every worker
+    // gets one shard over its own unix socket pair, computes a local hull and
+    // sends back only the hull vertices, which the coordinator merges
+    class ShardedHull {
+    public:
+        using AlgoFactory = std::function<std::unique_ptr<ConvexHullAlgorithm>()>;
+
+        ShardedHull(AlgoFactory make, int workers);
+
+        // shards are contiguous slices of pts sent inline
+        ShardedHullResult run(const std::vector<core::Point>& pts);
+
+        // workers read their own range of a point file, only the path crosses the
+        // socket. ids are int, so a file of more than INT_MAX + 1 points is refused
+        ShardedHullResult run(const std::string& point_file);
+
+    private:
+        AlgoFactory make_;
+        int workers_{1};
+
+        struct Worker {
+            int pid{-1};
+            int fd{-1};
+        };
+
+        // sends shard i of shards on fd and fills its outgoing stats
+        using ShardSender = std::function<void(int fd, std::size_t i, std::size_t shards, ShardStats& st)>;
+
+        std::vector<Worker> spawn() const;
+        ShardedHullResult dispatch(const ShardSender& send_shard) const;
+        ShardedHullResult collect(std::vector<Worker>& workers, std::vector<ShardStats>& stats) const;
+        static void reap(std::vector<Worker>& workers);
+
+        static void worker_main(int fd, const AlgoFactory& make);
+    };
+}
+
+#endif
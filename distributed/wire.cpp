@@ -0,0 +1,58 @@
+#include "distributed/wire.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace distributed {
+    std::vector<WireVertex> to_wire(const std::vector<core::Point>& pts) {
+        std::vector<WireVertex> out(pts.size());
+        for (std::size_t i = 0; i < pts.size(); ++i) out[i] = WireVertex{pts[i].x, pts[i].y, pts[i].id};
+        return out;
+    }
+
+    std::vector<core::Point> from_wire(const std::vector<WireVertex>& verts) {
+        std::vector<core::Point> out(verts.size());
+        for (std::size_t i = 0; i < verts.size(); ++i) out[i] = core::Point{verts[i].x, verts[i].y, verts[i].id};
+        return out;
+    }
+
+    void send_all(int fd, const void* data, std::size_t bytes) {
+        const auto* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t put = ::send(fd, p, bytes, MSG_NOSIGNAL);
+            if (put < 0 && errno == EINTR) continue;
+            if (put <= 0) throw std::runtime_error(std::string("send failed: ") + std::strerror(errno));
+            p += put;
+            bytes -= static_cast<std::size_t>(put);
+        }
+    }
+
+    bool recv_all(int fd, void* data, std::size_t bytes) {
+        auto* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            ssize_t got = ::recv(fd, p, bytes, 0);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            p += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+
+    void send_message(int fd, const MessageHeader& header, const void* payload) {
+        send_all(fd, &header, sizeof(header));
+        if (header.payload_bytes > 0) send_all(fd, payload, static_cast<std::size_t>(header.payload_bytes));
+    }
+
+    bool recv_header(int fd, MessageHeader& header) {
+        if (!recv_all(fd, &header, sizeof(header))) return false;
+        if (header.magic != kWireMagic) throw std::runtime_error("bad wire magic");
+        return true;
+    }
+
+    bool recv_payload(int fd, const MessageHeader& header, std::vector<char>& payload) {
+        payload.resize(static_cast<std::size_t>(header.payload_bytes));
+        return recv_all(fd, payload.data(), payload.size());
+    }
+}
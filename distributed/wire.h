@@ -0,0 +1,59 @@
+#ifndef DISTRIBUTED_WIRE_H
+#define DISTRIBUTED_WIRE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/types.h"
+
+// framing used between coordinator and workers, and between hull service
+// clients and the daemon, over a stream socket.
+// every message is one fixed header followed by payload_bytes of payload,
+// all fields in host byte order since both ends run on the same machine.
+namespace distributed {
+    constexpr std::uint32_t kWireMagic = 0x48574843; // "CHWH"
+
+    enum class MessageKind : std::uint32_t {
+        InlinePoints = 1, // payload is count WireVertex
+        FileRange    = 2, // payload is a point file path, points [first, first + count)
+        Hull         = 3, // payload is count WireVertex in CCW order
+        Error        = 4, // payload is a message
+        ShmPoints    = 5, // payload is a posix shared memory name holding count WireVertex
+        Stats        = 6, // request has no payload, the reply payload is text
+        HullIndices  = 7  // payload is count int32 indices into the request points, CCW
+    };
+
+    struct MessageHeader {
+        std::uint32_t magic{kWireMagic};
+        MessageKind kind{MessageKind::Error};
+        std::uint32_t shard{0};
+        std::uint32_t reserved{0};
+        std::uint64_t payload_bytes{0};
+        std::uint64_t first{0};
+        std::uint64_t count{0};
+        std::int64_t read_ns{0};
+        std::int64_t hull_ns{0};
+    };
+
+    // 12 bytes per vertex, the id is the global point id
+    struct WireVertex {
+        float x;
+        float y;
+        std::int32_t id;
+    };
+    static_assert(sizeof(WireVertex) == 12, "wire vertex must stay packed");
+
+    std::vector<WireVertex> to_wire(const std::vector<core::Point>& pts);
+    std::vector<core::Point> from_wire(const std::vector<WireVertex>& verts);
+
+    // blocking full transfers, send never raises SIGPIPE. recv returns false on a closed peer
+    void send_all(int fd, const void* data, std::size_t bytes);
+    bool recv_all(int fd, void* data, std::size_t bytes);
+
+    void send_message(int fd, const MessageHeader& header, const void* payload);
+    bool recv_header(int fd, MessageHeader& header);
+    bool recv_payload(int fd, const MessageHeader& header, std::vector<char>& payload);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "ball_generator.h"
+#include <algorithm>
+#include <random>
+
+using core::Point3;
+
+// points uniform inside a ball, rejection sampled from the bounding cube
+std::vector<Point3> BallGenerator::generate(std::size_t n, float w, float h, float d) {
+    std::vector<Point3> pts;
+    if (n == 0) return pts;
+    pts.reserve(n);
+
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+
+    const float cx = w * 0.5f;
+    const float cy = h * 0.5f;
+    const float cz = d * 0.5f;
+    const float r  = 0.45f * std::min({w, h, d});
+
+    while (pts.size() < n) {
+        float x = u(rng);
+        float y = u(rng);
+        float z = u(rng);
+        if (x * x + y * y + z * z > 1.0f) continue;
+        Point3 p{};
+        p.x = cx + r * x;
+        p.y = cy + r * y;
+        p.z = cz + r * z;
+        p.id = static_cast<int>(pts.size());
+        pts.push_back(p);
+    }
+    return pts;
+}
@@ -0,0 +1,12 @@
+#ifndef GENERATORS_BALL_GENERATOR_H
+#define GENERATORS_BALL_GENERATOR_H
+
+#include "point_generator3d.h"
+
+class BallGenerator final : public PointGenerator3D {
+public:
+    const char* name() const override { return "Ball"; }
+    std::vector<core::Point3> generate(std::size_t n, float w, float h, float d) override;
+};
+
+#endif
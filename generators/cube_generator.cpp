@@ -0,0 +1,43 @@
+#include "cube_generator.h"
+#include <algorithm>
+#include <random>
+
+using core::Point3;
+
+// points on the surface of an axis aligned cube, uniform over the six faces
+std::vector<Point3> CubeGenerator::generate(std::size_t n, float w, float h, float d) {
+    std::vector<Point3> pts;
+    if (n == 0) return pts;
+    pts.reserve(n);
+
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    std::uniform_int_distribution<int> face(0, 5);
+
+    const float s  = 0.9f * std::min({w, h, d});
+    const float x0 = w * 0.5f - s * 0.5f;
+    const float y0 = h * 0.5f - s * 0.5f;
+    const float z0 = d * 0.5f - s * 0.5f;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        float a = s * u(rng);
+        float b = s * u(rng);
+        float x, y, z;
+        switch (face(rng)) {
+            case 0:  x = 0.0f; y = a;    z = b;    break;
+            case 1:  x = s;    y = a;    z = b;    break;
+            case 2:  x = a;    y = 0.0f; z = b;    break;
+            case 3:  x = a;    y = s;    z = b;    break;
+            case 4:  x = a;    y = b;    z = 0.0f; break;
+            default: x = a;    y = b;    z = s;    break;
+        }
+        Point3 p{};
+        p.x = x0 + x;
+        p.y = y0 + y;
+        p.z = z0 + z;
+        p.id = static_cast<int>(pts.size());
+        pts.push_back(p);
+    }
+    return pts;
+}
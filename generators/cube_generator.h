@@ -0,0 +1,12 @@
+#ifndef GENERATORS_CUBE_GENERATOR_H
+#define GENERATORS_CUBE_GENERATOR_H
+
+#include "point_generator3d.h"
+
+class CubeGenerator final : public PointGenerator3D {
+public:
+    const char* name() const override { return "Cube"; }
+    std::vector<core::Point3> generate(std::size_t n, float w, float h, float d) override;
+};
+
+#endif
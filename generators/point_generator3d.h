@@ -0,0 +1,14 @@
+#ifndef GENERATORS_POINT_GENERATOR3D_H
+#define GENERATORS_POINT_GENERATOR3D_H
+
+#include <vector>
+#include "core/types.h"
+
+class PointGenerator3D {
+public:
+    virtual ~PointGenerator3D() = default;
+    virtual const char* name() const = 0;
+    virtual std::vector<core::Point3> generate(std::size_t n, float w, float h, float d) = 0;
+};
+
+#endif
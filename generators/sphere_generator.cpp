@@ -0,0 +1,37 @@
+#include "sphere_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using core::Point3;
+
+// points on the surface of a sphere, normalized gaussian directions
+std::vector<Point3> SphereGenerator::generate(std::size_t n, float w, float h, float d) {
+    std::vector<Point3> pts;
+    if (n == 0) return pts;
+    pts.reserve(n);
+
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::normal_distribution<float> g(0.0f, 1.0f);
+
+    const float cx = w * 0.5f;
+    const float cy = h * 0.5f;
+    const float cz = d * 0.5f;
+    const float r  = 0.45f * std::min({w, h, d});
+
+    while (pts.size() < n) {
+        float x = g(rng);
+        float y = g(rng);
+        float z = g(rng);
+        float len = std::sqrt(x * x + y * y + z * z);
+        if (len < 1e-6f) continue;
+        Point3 p{};
+        p.x = cx + r * x / len;
+        p.y = cy + r * y / len;
+        p.z = cz + r * z / len;
+        p.id = static_cast<int>(pts.size());
+        pts.push_back(p);
+    }
+    return pts;
+}
@@ -0,0 +1,12 @@
+#ifndef GENERATORS_SPHERE_GENERATOR_H
+#define GENERATORS_SPHERE_GENERATOR_H
+
+#include "point_generator3d.h"
+
+class SphereGenerator final : public PointGenerator3D {
+public:
+    const char* name() const override { return "Sphere"; }
+    std::vector<core::Point3> generate(std::size_t n, float w, float h, float d) override;
+};
+
+#endif
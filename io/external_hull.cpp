@@ -0,0 +1,160 @@
+#include "io/external_hull.h"
+#include "io/point_file.h"
+#include "io/hull_cache.h"
+#include "core/stopwatch.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace io {
+    ExternalHull::ExternalHull(AlgoFactory make, ExternalHullConfig cfg)
+        : make_(std::move(make)), cfg_(cfg) {
+        if (!make_) throw std::runtime_error("external hull needs an algorithm");
+    }
+
+    void ExternalHull::merge_into(ExternalHullResult& acc,
+                                  ConvexHullAlgorithm& merger,
+                                  const std::vector<core::Point>& block_hull,
+                                  std::uint64_t block_first) const {
+        // candidates are the running hull plus the new block hull, both small
+        std::vector<core::Point> cand;
+        std::vector<std::uint64_t> cand_index;
+        cand.reserve(acc.hull.size() + block_hull.size());
+        cand_index.reserve(acc.hull.size() + block_hull.size());
+        for (std::size_t i = 0; i < acc.hull.size(); ++i) {
+            cand.push_back(acc.hull[i]);
+            cand_index.push_back(acc.index[i]);
+        }
+        for (const core::Point& p : block_hull) {
+            cand.push_back(p);
+            cand_index.push_back(block_first + static_cast<std::uint64_t>(p.id));
+        }
+        for (std::size_t i = 0; i < cand.size(); ++i) cand[i].id = static_cast<int>(i);
+
+        merger.reset(cand);
+        std::vector<int> ids = merger.run_full();
+
+        acc.hull.clear();
+        acc.index.clear();
+        for (int id : ids) {
+            acc.hull.push_back(cand[id]);
+            acc.index.push_back(cand_index[id]);
+        }
+    }
+
+    ExternalHullResult ExternalHull::run(const std::string& path) {
+        PointFileReader reader(path);
+        const std::uint64_t n = reader.count();
+
+        ExternalHullResult acc;
+        acc.stats.points = n;
+        if (n == 0) return acc;
+
+        std::size_t block = std::max<std::size_t>(1024, cfg_.memory_budget / kBytesPerPoint);
+        if (block > n) block = static_cast<std::size_t>(n);
+        acc.stats.block_points = block;
+
+        std::vector<float> xs[2];
+        std::vector<float> ys[2];
+        for (int s = 0; s < 2; ++s) {
+            xs[s].resize(block);
+            ys[s].resize(block);
+        }
+
+        // optional mapping of the whole file, the next block's pages are hinted
+        // while this one is copied and dropped behind it, so resident size
+        // stays at about two blocks. the mapping outlives the pending load
+        const std::size_t file_bytes = static_cast<std::size_t>(kPointFileDataOffset + 2 * n * sizeof(float));
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        MappedFile mapped;
+        char* map = nullptr;
+        if (cfg_.use_mmap) {
+            mapped = MappedFile(path);
+            if (mapped.size() < file_bytes) throw std::runtime_error("point file is truncated: " + path);
+            map = const_cast<char*>(mapped.data());
+        }
+        auto advise = [&](std::uint64_t off, std::size_t bytes, int advice) {
+            std::uint64_t lo = off / page * page;
+            ::madvise(map + lo, static_cast<std::size_t>(off + bytes - lo), advice);
+        };
+        auto prefetch = [&](std::uint64_t first) {
+            if (first >= n) return;
+            const std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(block, n - first)) * sizeof(float);
+            advise(reader.x_offset(first), bytes, MADV_WILLNEED);
+            advise(reader.y_offset(first), bytes, MADV_WILLNEED);
+        };
+        if (map) prefetch(0);
+
+        auto load = [&](int slot, std::uint64_t first, std::size_t cnt) {
+            if (!map) {
+                reader.read_block(first, cnt, xs[slot].data(), ys[slot].data());
+                return;
+            }
+            const std::size_t bytes = cnt * sizeof(float);
+            prefetch(first + cnt);
+            std::memcpy(xs[slot].data(), map + reader.x_offset(first), bytes);
+            std::memcpy(ys[slot].data(), map + reader.y_offset(first), bytes);
+            advise(reader.x_offset(first), bytes, MADV_DONTNEED);
+            advise(reader.y_offset(first), bytes, MADV_DONTNEED);
+        };
+
+        std::unique_ptr<ConvexHullAlgorithm> algo = make_();
+        std::unique_ptr<ConvexHullAlgorithm> merger = make_();
+        std::vector<core::Point> pts;
+        pts.reserve(block);
+        std::vector<core::Point> block_hull;
+
+        Stopwatch sw;
+        std::uint64_t first = 0;
+        int slot = 0;
+        std::future<void> pending = std::async(std::launch::async, load, slot, first, block);
+
+        while (first < n) {
+            const std::size_t cnt = static_cast<std::size_t>(std::min<std::uint64_t>(block, n - first));
+
+            sw.start();
+            pending.get();
+            sw.stop();
+            acc.stats.io_wait_ns += sw.ns();
+
+            // start reading the next block into the other buffer
+            const std::uint64_t next = first + cnt;
+            if (next < n) {
+                const std::size_t next_cnt = static_cast<std::size_t>(std::min<std::uint64_t>(block, n - next));
+                pending = std::async(std::launch::async, load, slot ^ 1, next, next_cnt);
+            }
+
+            sw.start();
+            pts.resize(cnt);
+            for (std::size_t i = 0; i < cnt; ++i) {
+                pts[i].x = xs[slot][i];
+                pts[i].y = ys[slot][i];
+                pts[i].id = static_cast<int>(i);
+            }
+            algo->reset(pts);
+            std::vector<int> ids = algo->run_full();
+            block_hull.clear();
+            for (int id : ids) block_hull.push_back(pts[id]);
+            sw.stop();
+            acc.stats.hull_ns += sw.ns();
+
+            sw.start();
+            merge_into(acc, *merger, block_hull, first);
+            sw.stop();
+            acc.stats.merge_ns += sw.ns();
+
+            ++acc.stats.blocks;
+            first = next;
+            slot ^= 1;
+        }
+
+        for (std::size_t i = 0; i < acc.hull.size(); ++i) {
+            acc.hull[i].id = acc.index[i] <= static_cast<std::uint64_t>(INT_MAX) ? static_cast<int>(acc.index[i]) : -1;
+        }
+        return acc;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef IO_EXTERNAL_HULL_H
+#define IO_EXTERNAL_HULL_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+
+namespace io {
+    struct ExternalHullConfig {
+        std::size_t memory_budget{256u << 20}; // bytes for both block buffers and the per block hull work
+        bool use_mmap{false};                  // read through a readahead hinted mapping instead of pread
+    };
+
+    struct ExternalHullStats {
+        std::uint64_t points{0};
+        std::size_t blocks{0};
+        std::size_t block_points{0};
+        long long io_wait_ns{0}; // time the hull loop spent waiting for the reader
+        long long hull_ns{0};    // per block hulls
+        long long merge_ns{0};   // folding block hulls into the running hull
+    };
+
+    struct ExternalHullResult {
+        std::vector<core::Point> hull;    // CCW without repeating the first point
+        std::vector<std::uint64_t> index; // file position of each hull vertex, hull[i].id is the same when it fits an int
+        ExternalHullStats stats;
+    };
+
+    // hull of a point file that does not fit in memory. blocks are read
+    // sequentially into two alternating buffers, the next block loads on a
+    // reader thread while the current one is hulled and merged into the
+    // running hull, so peak memory is bounded by the configured budget
+    class ExternalHull {
+    public:
+        using AlgoFactory = std::function<std::unique_ptr<ConvexHullAlgorithm>()>;
+
+        ExternalHull(AlgoFactory make, ExternalHullConfig cfg);
+
+        ExternalHullResult run(const std::string& path);
+
+        // rough peak bytes per block point: two column buffers, the block
+        // vector handed to reset and the algorithm's own copy and scratch
+        static constexpr std::size_t kBytesPerPoint = 64;
+
+    private:
+        AlgoFactory make_;
+        ExternalHullConfig cfg_;
+
+        void merge_into(ExternalHullResult& acc,
+                        ConvexHullAlgorithm& merger,
+                        const std::vector<core::Point>& block_hull,
+                        std::uint64_t block_first) const;
+    };
+}
+
+#endif
@@ -0,0 +1,291 @@
+#include "io/hull_cache.h"
+#include "core/parallel.h"
+#include "io/point_file.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace io {
+    static_assert(sizeof(int) == sizeof(std::int32_t), "hull entries store ids as they are");
+
+    std::uint64_t fnv1a(const void* data, std::size_t bytes, std::uint64_t h) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < bytes; ++i) {
+            h ^= p[i];
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    std::uint64_t input_hash(const InputKey& key) {
+        // with its terminating zero, so one name is never a prefix of another
+        std::uint64_t h = fnv1a(key.generator.c_str(), key.generator.size() + 1);
+        h = fnv1a(&key.width, sizeof(key.width), h);
+        h = fnv1a(&key.height, sizeof(key.height), h);
+        h = fnv1a(&key.seed, sizeof(key.seed), h);
+        return fnv1a(&key.n, sizeof(key.n), h);
+    }
+
+    std::uint64_t hull_hash(std::uint64_t points, const std::string& algorithm) {
+        std::uint64_t h = fnv1a(&points, sizeof(points));
+        h = fnv1a(&kHullOutputVersion, sizeof(kHullOutputVersion), h);
+        return fnv1a(algorithm.c_str(), algorithm.size() + 1, h);
+    }
+
+    MappedFile::MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void* m = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            // hits are read front to back once, into points or ids
+            ::madvise(m, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(m);
+        }
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            if (data_) ::munmap(const_cast<char*>(data_), size_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    const float* CachedPoints::xs() const {
+        return reinterpret_cast<const float*>(file_.data() + kPointFileDataOffset);
+    }
+
+    const float* CachedPoints::ys() const {
+        return xs() + count_;
+    }
+
+    std::vector<core::Point> CachedPoints::to_points() const {
+        const auto n = static_cast<std::size_t>(count_);
+        const float* x = xs();
+        const float* y = ys();
+        std::vector<core::Point> pts(n);
+        core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned) {
+            for (std::size_t i = begin; i < end; ++i) pts[i] = core::Point{x[i], y[i], static_cast<int>(i)};
+        });
+        return pts;
+    }
+
+    const std::int32_t* CachedHull::ids() const {
+        return reinterpret_cast<const std::int32_t*>(file_.data() + sizeof(HullFileHeader));
+    }
+
+    std::vector<int> CachedHull::to_vector() const {
+        return std::vector<int>(ids(), ids() + count_);
+    }
+
+    HullCache::HullCache(HullCacheConfig cfg) : cfg_(std::move(cfg)) {}
+
+    std::string HullCache::entry_path(std::uint64_t key, const char* ext) const {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return cfg_.dir + "/" + name + ext;
+    }
+
+    std::string HullCache::temp_path(const std::string& path) const {
+        const std::size_t thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(thread);
+    }
+
+    void HullCache::touch(const std::string& path) {
+        std::error_code ec;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    }
+
+    std::optional<CachedPoints> HullCache::find_points(std::uint64_t key) {
+        const std::string path = entry_path(key, ".chpf");
+        std::error_code ec;
+        if (!fs::exists(path, ec)) return std::nullopt;
+        try {
+            CachedPoints out;
+            out.file_ = MappedFile(path);
+            PointFileHeader header{};
+            const PointFileHeader expect{};
+            if (out.file_.size() < sizeof(header)) throw std::runtime_error("short cache entry");
+            std::memcpy(&header, out.file_.data(), sizeof(header));
+            if (std::memcmp(header.magic, expect.magic, sizeof(header.magic)) != 0 || header.version != expect.version ||
+                header.content == 0 || out.file_.size() < kPointFileDataOffset + 2 * header.count * sizeof(float)) {
+                throw std::runtime_error("bad cache entry");
+            }
+            out.count_ = header.count;
+            out.content_ = header.content;
+            touch(path);
+            return out;
+        } catch (const std::exception&) {
+            // torn or foreign, the next store replaces it
+            fs::remove(path, ec);
+            return std::nullopt;
+        }
+    }
+
+    std::optional<CachedHull> HullCache::find_hull(std::uint64_t key, std::size_t points) {
+        const std::string path = entry_path(key, ".hull");
+        std::error_code ec;
+        if (!fs::exists(path, ec)) return std::nullopt;
+        try {
+            CachedHull out;
+            out.file_ = MappedFile(path);
+            HullFileHeader header{};
+            const HullFileHeader expect{};
+            if (out.file_.size() < sizeof(header)) throw std::runtime_error("short cache entry");
+            std::memcpy(&header, out.file_.data(), sizeof(header));
+            if (std::memcmp(header.magic, expect.magic, sizeof(header.magic)) != 0 || header.version != expect.version ||
+                out.file_.size() < sizeof(header) + header.count * sizeof(std::int32_t)) {
+                throw std::runtime_error("bad cache entry");
+            }
+            out.count_ = static_cast<std::size_t>(header.count);
+            const std::int32_t* ids = out.ids();
+            for (std::size_t i = 0; i < out.count_; ++i) {
+                if (ids[i] < 0 || static_cast<std::size_t>(ids[i]) >= points) throw std::runtime_error("hull of other points");
+            }
+            touch(path);
+            return out;
+        } catch (const std::exception&) {
+            fs::remove(path, ec);
+            return std::nullopt;
+        }
+    }
+
+    void HullCache::publish(const std::string& temp, const std::string& path) {
+        std::error_code ec;
+        fs::rename(temp, path, ec);
+        if (ec) {
+            fs::remove(temp, ec);
+            throw std::runtime_error("cannot publish cache entry " + path);
+        }
+        evict();
+    }
+
+    void HullCache::store_points(std::uint64_t key, const std::vector<core::Point>& pts, std::uint64_t content) {
+        fs::create_directories(cfg_.dir);
+        const std::string path = entry_path(key, ".chpf");
+        const std::string temp = temp_path(path);
+        try {
+            write_point_file(temp, pts, content);
+        } catch (...) {
+            std::error_code ec;
+            fs::remove(temp, ec);
+            throw;
+        }
+        publish(temp, path);
+    }
+
+    void HullCache::store_hull(std::uint64_t key, const std::vector<int>& hull) {
+        fs::create_directories(cfg_.dir);
+        const std::string path = entry_path(key, ".hull");
+        const std::string temp = temp_path(path);
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            HullFileHeader header{};
+            header.count = hull.size();
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(hull.data()), static_cast<std::streamsize>(hull.size() * sizeof(int)));
+            if (!out) {
+                std::error_code ec;
+                fs::remove(temp, ec);
+                throw std::runtime_error("cannot write cache entry " + path);
+            }
+        }
+        publish(temp, path);
+    }
+
+    std::vector<core::Point> HullCache::points(const InputKey& key, const std::function<std::vector<core::Point>()>& make,
+                                               std::uint64_t* content) {
+        const std::uint64_t h = input_hash(key);
+        if (std::optional<CachedPoints> hit = find_points(h)) {
+            if (content) *content = hit->content();
+            return hit->to_points();
+        }
+        std::vector<core::Point> pts = make();
+        const std::uint64_t c = points_hash(pts);
+        if (content) *content = c;
+        try {
+            store_points(h, pts, c);
+        } catch (const std::exception&) {
+            // a full disk or a read only directory only means generating again
+        }
+        return pts;
+    }
+
+    namespace {
+        struct Entry {
+            fs::file_time_type used;
+            std::uint64_t bytes;
+            fs::path path;
+        };
+
+        // cache entries in dir, temporary files of stores in flight are left out
+        std::vector<Entry> list_entries(const std::string& dir) {
+            std::vector<Entry> out;
+            std::error_code ec;
+            for (const fs::directory_entry& e : fs::directory_iterator(dir, ec)) {
+                const std::string ext = e.path().extension().string();
+                if (ext != ".chpf" && ext != ".hull") continue;
+                std::error_code entry_ec;
+                const std::uint64_t bytes = e.file_size(entry_ec);
+                const fs::file_time_type used = e.last_write_time(entry_ec);
+                if (entry_ec) continue; // evicted by someone else meanwhile
+                out.push_back(Entry{used, bytes, e.path()});
+            }
+            return out;
+        }
+    }
+
+    std::uint64_t HullCache::size_bytes() const {
+        std::uint64_t total = 0;
+        for (const Entry& e : list_entries(cfg_.dir)) total += e.bytes;
+        return total;
+    }
+
+    void HullCache::evict() {
+        std::lock_guard<std::mutex> lock(mu_);
+        std::vector<Entry> entries = list_entries(cfg_.dir);
+        std::uint64_t total = 0;
+        for (const Entry& e : entries) total += e.bytes;
+        if (total <= cfg_.budget_bytes) return;
+
+        // oldest use first. a mapped entry stays readable after removal
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.used < b.used; });
+        for (const Entry& e : entries) {
+            if (total <= cfg_.budget_bytes) break;
+            std::error_code ec;
+            fs::remove(e.path, ec);
+            total -= e.bytes;
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef IO_HULL_CACHE_H
+#define IO_HULL_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "core/types.h"
+
+// content addressed cache of generated inputs and their hulls on disk. an
+// input is named by what produced it, its generator, size, seed and count,
+// and a hull by the points_hash of the coordinates it was built over, the
+// algorithm and the output version. generators are not all seeded, so an
+// input generated again under the same name may differ, its hulls then are
+// simply missed. inputs are point files that record their points_hash,
+// hulls a small header and int32 ids, and a hit maps the file read only. an entry's modification time is
+// its last use, every store evicts the least recently used entries until the
+// directory fits the budget. the cache is best effort, a failed store leaves
+// the caller's data as it was
+namespace io {
+    struct HullCacheConfig {
+        std::string dir{"hull_cache"};
+        std::uint64_t budget_bytes{std::uint64_t{4} << 30};
+    };
+
+    // what a generated input is made from
+    struct InputKey {
+        std::string generator;
+        float width{0.0f};
+        float height{0.0f};
+        std::uint64_t seed{0};
+        std::uint64_t n{0};
+    };
+
+    // part of every hull's key. bumped whenever an algorithm's output for
+    // the same input changes, so hulls stored by an older build are missed
+    // rather than served
+    constexpr std::uint32_t kHullOutputVersion = 2;
+
+    struct HullFileHeader {
+        char magic[4]{'C', 'H', 'H', 'F'};
+        std::uint32_t version{kHullOutputVersion};
+        std::uint64_t count{0};
+    };
+
+    // 64 bit FNV-1a, continuing from h
+    std::uint64_t fnv1a(const void* data, std::size_t bytes, std::uint64_t h = 0xcbf29ce484222325ull);
+    std::uint64_t input_hash(const InputKey& key);
+    // points is the points_hash of the input
+    std::uint64_t hull_hash(std::uint64_t points, const std::string& algorithm);
+
+    // a whole file mapped read only, unmapped on destruction
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+    private:
+        const char* data_{nullptr};
+        std::size_t size_{0};
+    };
+
+    // the x and y columns of a cached input
+    class CachedPoints {
+    public:
+        std::uint64_t count() const { return count_; }
+        // points_hash of the coordinates, as stored
+        std::uint64_t content() const { return content_; }
+        const float* xs() const;
+        const float* ys() const;
+
+        // ids are positions, as read_point_file gives them
+        std::vector<core::Point> to_points() const;
+
+    private:
+        friend class HullCache;
+        MappedFile file_;
+        std::uint64_t count_{0};
+        std::uint64_t content_{0};
+    };
+
+    class CachedHull {
+    public:
+        std::size_t size() const { return count_; }
+        const std::int32_t* ids() const;
+
+        std::vector<int> to_vector() const;
+
+    private:
+        friend class HullCache;
+        MappedFile file_;
+        std::size_t count_{0};
+    };
+
+    // safe to share between threads, entries are written under a temporary
+    // name and renamed into place
+    class HullCache {
+    public:
+        explicit HullCache(HullCacheConfig cfg = {});
+
+        std::optional<CachedPoints> find_points(std::uint64_t key);
+        // a hull with an id outside [0, points) is dropped as a miss
+        std::optional<CachedHull> find_hull(std::uint64_t key, std::size_t points);
+        void store_points(std::uint64_t key, const std::vector<core::Point>& pts, std::uint64_t content);
+        void store_hull(std::uint64_t key, const std::vector<int>& hull);
+
+        // the cached input, or the one make returns after storing it. content
+        // receives its points_hash, the key of its hulls
+        std::vector<core::Point> points(const InputKey& key, const std::function<std::vector<core::Point>()>& make,
+                                        std::uint64_t* content = nullptr);
+
+        // bytes of all entries on disk
+        std::uint64_t size_bytes() const;
+
+        // removes least recently used entries until the rest fit the budget,
+        // an entry larger than the whole budget goes as well
+        void evict();
+
+    private:
+        HullCacheConfig cfg_;
+        std::mutex mu_; // one eviction at a time
+
+        std::string entry_path(std::uint64_t key, const char* ext) const;
+        std::string temp_path(const std::string& path) const;
+        void publish(const std::string& temp, const std::string& path);
+        // a hit counts as a use for the eviction order
+        static void touch(const std::string& path);
+    };
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "io/point_file.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace io {
+    static std::runtime_error io_error(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    // pread and pwrite may transfer less than asked, loop until done
+    static void pread_all(int fd, void* dst, std::size_t bytes, std::uint64_t off) {
+        auto* p = static_cast<char*>(dst);
+        while (bytes > 0) {
+            ssize_t got = ::pread(fd, p, bytes, static_cast<off_t>(off));
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) throw io_error("short read from", "point file");
+            p += got;
+            off += static_cast<std::uint64_t>(got);
+            bytes -= static_cast<std::size_t>(got);
+        }
+    }
+
+    static void pwrite_all(int fd, const void* src, std::size_t bytes, std::uint64_t off) {
+        const auto* p = static_cast<const char*>(src);
+        while (bytes > 0) {
+            ssize_t put = ::pwrite(fd, p, bytes, static_cast<off_t>(off));
+            if (put < 0 && errno == EINTR) continue;
+            if (put <= 0) throw io_error("short write to", "point file");
+            p += put;
+            off += static_cast<std::uint64_t>(put);
+            bytes -= static_cast<std::size_t>(put);
+        }
+    }
+
+    std::uint64_t points_hash(const std::vector<core::Point>& pts) {
+        // FNV-1a over 32 bit words, a block at a time in parallel. the block
+        // hashes are then folded in order, so the split never shows
+        constexpr std::uint64_t kBasis = 0xcbf29ce484222325ull;
+        constexpr std::uint64_t kPrime = 0x100000001b3ull;
+        constexpr std::size_t kBlock = std::size_t{1} << 16;
+        const std::size_t blocks = (pts.size() + kBlock - 1) / kBlock;
+        std::vector<std::uint64_t> block_hash(blocks);
+        core::parallel_chunks(blocks, [&](std::size_t begin, std::size_t end, unsigned) {
+            for (std::size_t b = begin; b < end; ++b) {
+                std::uint64_t h = kBasis;
+                const std::size_t last = std::min(pts.size(), (b + 1) * kBlock);
+                for (std::size_t i = b * kBlock; i < last; ++i) {
+                    h = (h ^ std::bit_cast<std::uint32_t>(pts[i].x)) * kPrime;
+                    h = (h ^ std::bit_cast<std::uint32_t>(pts[i].y)) * kPrime;
+                }
+                block_hash[b] = h;
+            }
+        }, 1);
+        std::uint64_t h = (kBasis ^ pts.size()) * kPrime;
+        for (std::uint64_t b : block_hash) h = (h ^ b) * kPrime;
+        return h == 0 ? 1 : h;
+    }
+
+    PointFileWriter::PointFileWriter(const std::string& path, std::uint64_t count, std::uint64_t content)
+        : count_(count) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) throw io_error("cannot create", path);
+        PointFileHeader header{};
+        header.count = count;
+        header.content = content;
+        pwrite_all(fd_, &header, sizeof(header), 0);
+        if (::ftruncate(fd_, static_cast<off_t>(kPointFileDataOffset + 2 * count * sizeof(float))) != 0) {
+            ::close(fd_);
+            throw io_error("cannot size", path);
+        }
+    }
+
+    PointFileWriter::~PointFileWriter() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void PointFileWriter::write_block(std::uint64_t first, const std::vector<core::Point>& pts) {
+        if (first + pts.size() > count_) throw std::runtime_error("point file block out of range");
+        std::vector<float> col(pts.size());
+        for (std::size_t i = 0; i < pts.size(); ++i) col[i] = pts[i].x;
+        pwrite_all(fd_, col.data(), col.size() * sizeof(float), kPointFileDataOffset + first * sizeof(float));
+        for (std::size_t i = 0; i < pts.size(); ++i) col[i] = pts[i].y;
+        pwrite_all(fd_, col.data(), col.size() * sizeof(float), kPointFileDataOffset + (count_ + first) * sizeof(float));
+    }
+
+    PointFileReader::PointFileReader(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) throw io_error("cannot open", path);
+        PointFileHeader header{};
+        PointFileHeader expect{};
+        pread_all(fd_, &header, sizeof(header), 0);
+        if (std::memcmp(header.magic, expect.magic, sizeof(header.magic)) != 0 || header.version != expect.version) {
+            ::close(fd_);
+            throw std::runtime_error("not a point file: " + path);
+        }
+        count_ = header.count;
+        content_ = header.content;
+    }
+
+    PointFileReader::~PointFileReader() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void PointFileReader::read_block(std::uint64_t first, std::size_t n, float* xs, float* ys) const {
+        if (first + n > count_) throw std::runtime_error("point file block out of range");
+        pread_all(fd_, xs, n * sizeof(float), x_offset(first));
+        pread_all(fd_, ys, n * sizeof(float), y_offset(first));
+    }
+
+    void write_point_file(const std::string& path, const std::vector<core::Point>& pts, std::uint64_t content) {
+        PointFileWriter w(path, pts.size(), content != 0 ? content : points_hash(pts));
+        w.write_block(0, pts);
+    }
+
+    std::vector<core::Point> read_point_file(const std::string& path) {
+        PointFileReader r(path);
+        const auto n = static_cast<std::size_t>(r.count());
+        std::vector<float> xs(n);
+        std::vector<float> ys(n);
+        r.read_block(0, n, xs.data(), ys.data());
+
+        std::vector<core::Point> pts(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            pts[i].x = xs[i];
+            pts[i].y = ys[i];
+            pts[i].id = static_cast<int>(i);
+        }
+        return pts;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef IO_POINT_FILE_H
+#define IO_POINT_FILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/types.h"
+
+// binary point file, columnar layout:
+//   header, then count x values as float32, then count y values as float32.
+// ids are implicit, a point's id is its position in the file.
+namespace io {
+    struct PointFileHeader {
+        char magic[4]{'C', 'H', 'P', 'F'};
+        std::uint32_t version{2};
+        std::uint64_t count{0};
+        std::uint64_t content{0}; // points_hash of the coordinates, 0 when the writer did not know it
+    };
+
+    constexpr std::uint64_t kPointFileDataOffset = sizeof(PointFileHeader);
+
+    // hash of the x and y values in order, ids left out. never 0, and the
+    // same on every machine however many workers compute it
+    std::uint64_t points_hash(const std::vector<core::Point>& pts);
+
+    // writes blocks at their final position, so a file can be produced
+    // without holding all points in memory
+    class PointFileWriter {
+    public:
+        PointFileWriter(const std::string& path, std::uint64_t count, std::uint64_t content = 0);
+        ~PointFileWriter();
+        PointFileWriter(const PointFileWriter&) = delete;
+        PointFileWriter& operator=(const PointFileWriter&) = delete;
+
+        void write_block(std::uint64_t first, const std::vector<core::Point>& pts);
+
+    private:
+        int fd_{-1};
+        std::uint64_t count_{0};
+    };
+
+    class PointFileReader {
+    public:
+        explicit PointFileReader(const std::string& path);
+        ~PointFileReader();
+        PointFileReader(const PointFileReader&) = delete;
+        PointFileReader& operator=(const PointFileReader&) = delete;
+
+        std::uint64_t count() const { return count_; }
+        std::uint64_t content() const { return content_; }
+        int fd() const { return fd_; }
+
+        // byte offsets of point i in the x and y columns
+        std::uint64_t x_offset(std::uint64_t i) const { return kPointFileDataOffset + i * sizeof(float); }
+        std::uint64_t y_offset(std::uint64_t i) const { return kPointFileDataOffset + (count_ + i) * sizeof(float); }
+
+        // read points [first, first + n) with pread into the two columns
+        void read_block(std::uint64_t first, std::size_t n, float* xs, float* ys) const;
+
+    private:
+        int fd_{-1};
+        std::uint64_t count_{0};
+        std::uint64_t content_{0};
+    };
+
+    // records points_hash(pts) unless content is given
+    void write_point_file(const std::string& path, const std::vector<core::Point>& pts, std::uint64_t content = 0);
+    std::vector<core::Point> read_point_file(const std::string& path);
+}
+
+#endif
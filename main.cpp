@@ -1,19 +1,110 @@
 #include "visualizer/app.h"
 #include "algorithms/quickhull.h"
 #include "algorithms/andrew_algorithm.h"
+#include "algorithms/approx_hull.h"
+#include "algorithms/grid_hull.h"
+#include "algorithms/jarvis_march.h"
+#include "algorithms/hull_analytics.h"
+#include "algorithms/hull_pipeline.h"
+#include "algorithms/hull_verifier.h"
+#include "algorithms/melkman.h"
+#include "algorithms/quickhull3d.h"
+#include "algorithms/sliding_window_hull.h"
 #include "core/stopwatch.h"
+#include "generators/ball_generator.h"
 #include "generators/circle_generator.h"
+#include "generators/cube_generator.h"
 #include "generators/line_generator.h"
 #include "generators/random_generator.h"
+#include "generators/sphere_generator.h"
 #include "generators/square_generator.h"
+#include "bench/results.h"
+#include "distributed/sharded_hull.h"
+#include "io/external_hull.h"
+#include "io/hull_cache.h"
+#include "io/point_file.h"
+#include "service/hull_client.h"
+#include "service/hull_service.h"
+#include "visualizer/offline_renderer.h"
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
+#include <unistd.h>
+
+static service::HullService* g_service = nullptr;
+
+static void on_stop_signal(int) {
+    if (g_service) g_service->stop();
+}
+
+static void report_check(const HullVerifier& verifier, const std::vector<core::Point>& pts, const std::vector<int>& hull) {
+    Stopwatch sw;
+    sw.start();
+    HullVerifyResult res = verifier.verify(pts, hull);
+    sw.stop();
+    if (res.ok) std::cout << "  verified: " << sw.ns() << "ns" << std::endl;
+    else std::cout << "  verify failed: " << res.error << std::endl;
+}
+
+// small inputs that once gave a wrong hull, checked against every algorithm
+// before the timings
+struct EdgeCase {
+    const char* name;
+    std::vector<core::Point> pts;
+};
+
+static std::vector<EdgeCase> edge_cases() {
+    auto make = [](const char* name, std::initializer_list<std::pair<float, float>> xy) {
+        EdgeCase e{name, {}};
+        for (const auto& [x, y] : xy) e.pts.push_back(core::Point{x, y, static_cast<int>(e.pts.size())});
+        return e;
+    };
+    std::vector<EdgeCase> out;
+    out.push_back(make("ring through its first point and on", {{3, -1}, {5, 2}, {2, 6}, {-9, 1}, {-2, -1}, {3, -1}, {9, -2}, {-9, 5}, {-10, 3}}));
+    out.push_back(make("negative zero next to zero", {{-0.0f, 5}, {0, 1}, {0, 3}, {2, 0}, {2, 6}}));
+    return out;
+}
+
+static void check_edge_cases(const std::vector<AlgoSpec>& algoSpecs, const HullVerifier& verifier) {
+    std::size_t failed = 0;
+    const std::vector<EdgeCase> cases = edge_cases();
+    for (const EdgeCase& e : cases) {
+        for (const AlgoSpec& spec : algoSpecs) {
+            std::unique_ptr<ConvexHullAlgorithm> algo = spec.make();
+            algo->reset(e.pts);
+            const HullVerifyResult res = verifier.verify(e.pts, algo->run_full());
+            if (res.ok) continue;
+            ++failed;
+            std::cout << "  " << algo->name() << " on " << e.name << ": " << res.error << std::endl;
+        }
+    }
+    std::cout << "Edge cases: " << cases.size() << " inputs, " << failed << " failures" << std::endl;
+}
+
+// a generated input as the last run with the same generator, size and count
+// left it in the cache, generated and stored when there is none
+static std::vector<core::Point> cached_input(io::HullCache& cache, PointGenerator& gen, std::size_t n, float w, float h) {
+    return cache.points(io::InputKey{gen.name(), w, h, 0, n}, [&] { return gen.generate(n, w, h); });
+}
 
 int main() {
     std::vector<AlgoSpec> algoSpecs;
     algoSpecs.emplace_back([] { return std::make_unique<Quickhull>(); });
     algoSpecs.emplace_back([] { return std::make_unique<AndrewAlgorithm>(); });
+    algoSpecs.emplace_back([] { return std::make_unique<MelkmanAlgorithm>(); });
+    algoSpecs.emplace_back([] { return std::make_unique<GridHullAlgorithm>(); });
+    algoSpecs.emplace_back([] { return std::make_unique<JarvisMarch>(); });
+    algoSpecs.emplace_back([] {
+        return std::make_unique<PipelineAlgorithm<HullPipeline<pipeline::AklToussaint, pipeline::RadixSort, pipeline::MonotoneChain<>>>>();
+    });
 
     std::vector<GenSpec> genSpecs;
     genSpecs.push_back(GenSpec{ [] { return std::make_unique<RandomGenerator>(); } });
@@ -24,32 +115,569 @@ int main() {
     std::cout << "choose mode\n";
     std::cout << "1 visual player\n";
     std::cout << "2 performance only\n";
+    std::cout << "3 performance 3d\n";
+    std::cout << "4 out of core hull from point file\n";
+    std::cout << "5 sharded hull over local worker processes\n";
+    std::cout << "6 hull service daemon\n";
+    std::cout << "7 hull service client\n";
+    std::cout << "8 render stepping frames to png\n";
+    std::cout << "9 sliding window hull throughput\n";
+    std::cout << "10 warm started hull over moving points\n";
+    std::cout << "11 approximate hull against the exact one\n";
+    std::cout << "12 compile time pipeline against type erased stages\n";
+    std::cout << "13 hull analytics, rotating calipers against the naive scans\n";
     int mode = 1;
     std::cin >> mode;
     std::cin.ignore();
 
+    HullVerifier verifier;
+    io::HullCache cache;
+
     if (mode == 2) {
-        Stopwatch sw;
-        sw.reset();
+        std::cout << "repetitions per run, 2 or more for bench_compare to test significance\n";
+        int reps = 5;
+        std::cin >> reps;
+        reps = std::max(1, reps);
+
+        const std::size_t n = 100000;
+        std::vector<bench::Sample> samples;
+
+        check_edge_cases(algoSpecs, verifier);
 
         for (const GenSpec& genSpec : genSpecs) {
             std::unique_ptr<PointGenerator> points = genSpec.make();
 
             std::cout << "\nRunning with <" << points->name() << "> point placement:" << std::endl;
 
+            // every algorithm, and every later run, on the same input
+            const std::vector<core::Point> pts = cached_input(cache, *points, n, 2000.0f, 1200.0f);
+
             for (const AlgoSpec& spec : algoSpecs) {
                 std::unique_ptr<ConvexHullAlgorithm> algo = spec.make();
-                algo->reset(points->generate(100000, 2000.0f, 1200.0f));
+
+                std::vector<int> hull;
+                for (int r = 0; r < reps; ++r) {
+                    algo->reset(pts);
+                    Stopwatch sw;
+                    sw.start();
+                    hull = algo->run_full();
+                    sw.stop();
+                    samples.push_back(bench::Sample{algo->name(), points->name(), n, sw.ns()});
+                }
+
+                algo->report(samples.back().ns, hull.size());
+                report_check(verifier, pts, hull);
+            }
+        }
+
+        // the first run on a machine becomes its baseline
+        const std::string machine = bench::machine_name();
+        bench::write_results(bench::latest_path(machine), samples);
+        std::cout << "\nResults written to " << bench::latest_path(machine) << std::endl;
+        if (!std::filesystem::exists(bench::baseline_path(machine))) {
+            bench::write_results(bench::baseline_path(machine), samples);
+            std::cout << "No baseline for " << machine << " yet, this run is it" << std::endl;
+        } else {
+            std::cout << "Compare against the baseline with bench_compare" << std::endl;
+        }
+
+        return 0;
+    }
+
+    if (mode == 3) {
+        std::vector<std::function<std::unique_ptr<PointGenerator3D>()>> gen3Specs;
+        gen3Specs.emplace_back([] { return std::make_unique<SphereGenerator>(); });
+        gen3Specs.emplace_back([] { return std::make_unique<CubeGenerator>(); });
+        gen3Specs.emplace_back([] { return std::make_unique<BallGenerator>(); });
+
+        const std::size_t sizes[] = {100000, 1000000, 10000000};
+        Stopwatch sw;
+        sw.reset();
+
+        for (const auto& make : gen3Specs) {
+            std::unique_ptr<PointGenerator3D> points = make();
+
+            for (std::size_t n : sizes) {
+                std::cout << "\nRunning with <" << points->name() << "> point placement, n = " << n << ":" << std::endl;
+
+                Quickhull3D algo;
+                algo.reset(points->generate(n, 2000.0f, 1200.0f, 1600.0f));
 
                 sw.start();
-                std::vector<int> hull = algo->run_full();
+                std::vector<core::Triangle> hull = algo.run_full();
                 sw.stop();
                 long long ns = sw.ns();
 
-                algo->report(ns, hull.size());
+                algo.report(ns, hull.size());
+            }
+        }
+
+        return 0;
+    }
+
+    if (mode == 4) {
+        std::string path;
+        std::cout << "point file path\n";
+        std::getline(std::cin, path);
+        std::cout << "points to generate into it first, 0 keeps the existing file\n";
+        unsigned long long gen_n = 0;
+        std::cin >> gen_n;
+        std::cout << "memory budget in MB\n";
+        std::size_t budget_mb = 256;
+        std::cin >> budget_mb;
+        std::cout << "reader, 1 pread, 2 mmap\n";
+        int reader = 1;
+        std::cin >> reader;
+
+        if (gen_n > 0) {
+            RandomGenerator gen;
+            io::PointFileWriter writer(path, gen_n);
+            const unsigned long long chunk = 1ull << 22;
+            for (unsigned long long first = 0; first < gen_n; first += chunk) {
+                std::size_t cnt = static_cast<std::size_t>(std::min(chunk, gen_n - first));
+                std::vector<core::Point> block = gen.generate(cnt, 2000.0f, 1200.0f);
+                block.resize(cnt);
+                writer.write_block(first, block);
             }
         }
 
+        io::ExternalHullConfig cfg;
+        cfg.memory_budget = budget_mb << 20;
+        cfg.use_mmap = reader == 2;
+        io::ExternalHull ext([] { return std::make_unique<AndrewAlgorithm>(); }, cfg);
+
+        Stopwatch sw;
+        sw.start();
+        io::ExternalHullResult res = ext.run(path);
+        sw.stop();
+
+        std::cout << "External hull: " << sw.ns() << "ns, hull size: " << res.hull.size()
+                  << ", points: " << res.stats.points
+                  << ", blocks: " << res.stats.blocks << " of " << res.stats.block_points
+                  << ", io wait: " << res.stats.io_wait_ns << "ns"
+                  << ", block hulls: " << res.stats.hull_ns << "ns"
+                  << ", merges: " << res.stats.merge_ns << "ns" << std::endl;
+        return 0;
+    }
+
+    if (mode == 5) {
+        std::string path;
+        std::cout << "point file path, empty for generated points\n";
+        std::getline(std::cin, path);
+        std::cout << "worker processes\n";
+        int workers = 4;
+        std::cin >> workers;
+        std::size_t n = 1000000;
+        if (path.empty()) {
+            std::cout << "points\n";
+            std::cin >> n;
+        }
+
+        distributed::ShardedHull sharded([] { return std::make_unique<Quickhull>(); }, workers);
+        std::vector<core::Point> pts;
+        if (path.empty()) pts = RandomGenerator().generate(n, 2000.0f, 1200.0f);
+        distributed::ShardedHullResult res = path.empty() ? sharded.run(pts) : sharded.run(path);
+
+        for (const distributed::ShardStats& st : res.shards) {
+            std::cout << "Shard " << st.shard << ": " << st.points << " points, hull size: " << st.hull_size
+                      << ", read: " << st.read_ns << "ns, hull: " << st.hull_ns << "ns"
+                      << ", round trip: " << st.round_trip_ns << "ns"
+                      << ", bytes out: " << st.bytes_out << ", bytes in: " << st.bytes_in << std::endl;
+        }
+        std::cout << "Sharded hull: " << res.total_ns << "ns, hull size: " << res.hull.size()
+                  << ", merge: " << res.merge_ns << "ns" << std::endl;
+        if (!pts.empty()) {
+            std::vector<int> hull;
+            hull.reserve(res.hull.size());
+            for (const core::Point& p : res.hull) hull.push_back(p.id);
+            report_check(verifier, pts, hull);
+        }
+        return 0;
+    }
+
+    if (mode == 6 || mode == 7) {
+        std::string path;
+        std::cout << "socket path, empty for the default\n";
+        std::getline(std::cin, path);
+        service::HullServiceConfig cfg;
+        if (!path.empty()) cfg.socket_path = path;
+
+        if (mode == 6) {
+            std::cout << "worker threads\n";
+            std::cin >> cfg.workers;
+
+            service::HullService svc([] { return std::make_unique<AndrewAlgorithm>(); }, cfg);
+            g_service = &svc;
+            std::signal(SIGINT, on_stop_signal);
+            std::signal(SIGTERM, on_stop_signal);
+            std::cout << "serving on " << cfg.socket_path << ", ctrl c stops" << std::endl;
+            svc.run();
+            g_service = nullptr;
+            std::cout << svc.stats_text();
+            return 0;
+        }
+
+        std::cout << "points per request\n";
+        std::size_t n = 1000;
+        std::cin >> n;
+        std::cout << "requests\n";
+        int requests = 100;
+        std::cin >> requests;
+
+        RandomGenerator gen;
+        std::vector<core::Point> pts = gen.generate(n, 2000.0f, 1200.0f);
+        service::SharedPointSet shared("/convex_hull_client_" + std::to_string(::getpid()), pts);
+        service::HullClient client(cfg.socket_path);
+
+        Stopwatch sw;
+        std::size_t hull_size = 0;
+        sw.start();
+        for (int i = 0; i < requests; ++i) hull_size = client.hull(pts).size();
+        sw.stop();
+        std::cout << "Inline: " << sw.ns() / std::max(1, requests) << "ns per request, hull size: " << hull_size << std::endl;
+
+        sw.start();
+        for (int i = 0; i < requests; ++i) hull_size = client.hull(shared).size();
+        sw.stop();
+        std::cout << "Shared memory: " << sw.ns() / std::max(1, requests) << "ns per request, hull size: " << hull_size << std::endl;
+        report_check(verifier, pts, client.hull(pts));
+
+        std::cout << client.stats();
+        return 0;
+    }
+
+    if (mode == 8) {
+        std::cout << "algorithm, 1 to " << algoSpecs.size() << "\n";
+        std::size_t algo_index = 1;
+        std::cin >> algo_index;
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 1;
+        std::cin >> gen_index;
+        std::cout << "points\n";
+        std::size_t n = 100000;
+        std::cin >> n;
+        std::cin.ignore();
+        OfflineRenderConfig cfg;
+        std::cout << "output directory, empty for " << cfg.out_dir << "\n";
+        std::string dir;
+        std::getline(std::cin, dir);
+        if (!dir.empty()) cfg.out_dir = dir;
+        std::cout << "frame stride\n";
+        std::cin >> cfg.stride;
+        std::cout << "max frames, 0 for no limit\n";
+        std::cin >> cfg.max_frames;
+
+        algo_index = std::clamp<std::size_t>(algo_index, 1, algoSpecs.size());
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        std::unique_ptr<ConvexHullAlgorithm> algo = algoSpecs[algo_index - 1].make();
+        std::vector<core::Point> pts = genSpecs[gen_index - 1].make()->generate(
+            n, static_cast<float>(cfg.width), static_cast<float>(cfg.height));
+
+        OfflineRenderer offline(cfg);
+        OfflineRenderStats st = offline.render(*algo, pts);
+        std::cout << "Rendered " << st.frames_written << " of " << st.frames_seen << " frames, stride " << st.stride
+                  << " into " << cfg.out_dir << ": " << st.total_ns << "ns"
+                  << ", render: " << st.render_ns << "ns, queue wait: " << st.wait_ns << "ns"
+                  << ", encode: " << st.encode_ns << "ns" << std::endl;
+        return 0;
+    }
+
+    if (mode == 9) {
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 1;
+        std::cin >> gen_index;
+        std::cout << "window points\n";
+        std::size_t window = 100000;
+        std::cin >> window;
+        std::cout << "updates\n";
+        unsigned long long updates = 100000000;
+        std::cin >> updates;
+        std::cout << "read the hull every this many updates, 0 for never\n";
+        unsigned long long query_every = 0;
+        std::cin >> query_every;
+        if (window == 0) {
+            std::cout << "The window needs room for at least one point" << std::endl;
+            return 1;
+        }
+
+        // the stream cycles through a generated pool, ids are stream positions
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        const std::size_t pool_size = 1u << 20;
+        std::vector<core::Point> pool = genSpecs[gen_index - 1].make()->generate(pool_size, 2000.0f, 1200.0f);
+        if (pool.empty()) return 0;
+        updates = std::min<unsigned long long>(updates, std::numeric_limits<int>::max());
+
+        // start() zeroes a stopwatch, so each stretch is added to a total
+        SlidingWindowHull sliding(window);
+        Stopwatch sw;
+        long long push_total = 0;
+        long long query_total = 0;
+        unsigned long long queries = 0;
+        std::size_t hull_total = 0;
+        sw.start();
+        for (unsigned long long i = 0; i < updates; ++i) {
+            core::Point p = pool[i % pool.size()];
+            p.id = static_cast<int>(i);
+            sliding.push(p, static_cast<double>(i));
+            if (query_every > 0 && (i + 1) % query_every == 0) {
+                sw.stop();
+                push_total += sw.ns();
+                sw.start();
+                hull_total += sliding.hull().size();
+                sw.stop();
+                query_total += sw.ns();
+                ++queries;
+                sw.start();
+            }
+        }
+        sw.stop();
+        push_total += sw.ns();
+
+        const double push_ns = static_cast<double>(push_total) / std::max<unsigned long long>(1, updates);
+        std::cout << "Sliding window of " << window << ": " << updates << " updates, " << push_ns << "ns per update, "
+                  << (push_ns > 0.0 ? 1e9 / push_ns : 0.0) << " updates per second" << std::endl;
+        if (queries > 0) {
+            std::cout << "  hull reads: " << queries << ", " << query_total / static_cast<long long>(queries)
+                      << "ns each, average hull size: " << hull_total / queries << std::endl;
+        }
+
+        // the final window against its own point set
+        const unsigned long long first = updates - sliding.size();
+        std::vector<core::Point> pts;
+        pts.reserve(sliding.size());
+        for (unsigned long long i = first; i < updates; ++i) pts.push_back(pool[i % pool.size()]);
+        std::vector<int> hull;
+        for (const core::Point& p : sliding.hull()) hull.push_back(static_cast<int>(p.id - first));
+        report_check(verifier, pts, hull);
+        return 0;
+    }
+
+    if (mode == 10) {
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 1;
+        std::cin >> gen_index;
+        std::cout << "points\n";
+        std::size_t n = 1000000;
+        std::cin >> n;
+        std::cout << "ticks\n";
+        int ticks = 20;
+        std::cin >> ticks;
+        std::cout << "largest move per tick\n";
+        float step = 1.0f;
+        std::cin >> step;
+
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        std::vector<core::Point> pts = cached_input(cache, *genSpecs[gen_index - 1].make(), n, 2000.0f, 1200.0f);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> move(-step, step);
+
+        Quickhull warm;
+        Quickhull cold;
+        warm.reset(pts);
+        std::vector<int> hull = warm.run_full();
+        // start() zeroes a stopwatch, so each tick is added to a total
+        Stopwatch sw;
+        long long warm_total = 0;
+        long long cold_total = 0;
+        int fell_back = 0;
+        for (int t = 0; t < ticks; ++t) {
+            for (core::Point& p : pts) {
+                p.x += move(rng);
+                p.y += move(rng);
+            }
+            warm.reset(pts);
+            sw.start();
+            hull = warm.run_warm(hull);
+            sw.stop();
+            warm_total += sw.ns();
+            fell_back += warm.warm_fell_back();
+
+            cold.reset(pts);
+            sw.start();
+            std::vector<int> full = cold.run_full();
+            sw.stop();
+            cold_total += sw.ns();
+            if (full.size() != hull.size()) {
+                std::cout << "  tick " << t << ": warm hull size " << hull.size() << ", full " << full.size() << std::endl;
+            }
+        }
+        const long long per = std::max(1, ticks);
+        std::cout << "Warm start: " << warm_total / per << "ns per tick, full run: " << cold_total / per
+                  << "ns per tick, fell back on " << fell_back << " of " << ticks << " ticks, hull size: " << hull.size() << std::endl;
+        report_check(verifier, pts, hull);
+        return 0;
+    }
+
+    if (mode == 11) {
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 1;
+        std::cin >> gen_index;
+        std::cout << "points\n";
+        std::size_t n = 10000000;
+        std::cin >> n;
+        std::cout << "epsilon, relative to the bounding box diagonal\n";
+        double epsilon = 1e-3;
+        std::cin >> epsilon;
+        if (!(epsilon >= ApproxHull::min_epsilon())) {
+            std::cout << "Epsilon must be at least " << ApproxHull::min_epsilon() << std::endl;
+            return 1;
+        }
+
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        std::vector<core::Point> pts = cached_input(cache, *genSpecs[gen_index - 1].make(), n, 2000.0f, 1200.0f);
+
+        Quickhull exact;
+        exact.reset(pts);
+        Stopwatch exact_sw;
+        exact_sw.start();
+        std::vector<int> hull = exact.run_full();
+        exact_sw.stop();
+        exact.report(exact_sw.ns(), static_cast<int>(hull.size()));
+
+        ApproxHull approx(epsilon);
+        Stopwatch approx_sw;
+        approx_sw.start();
+        ApproxHullResult res = approx.run(pts);
+        approx_sw.stop();
+        std::cout << "Approximate: " << approx_sw.ns() << "ns, hull size: " << res.hull.size()
+                  << ", sectors: " << res.sectors << ", error bound: " << res.error << std::endl;
+
+        // the verifier's tolerance is relative to the hull's bounding box
+        if (!res.hull.empty()) {
+            float min_x = pts[res.hull[0]].x, max_x = min_x, min_y = pts[res.hull[0]].y, max_y = min_y;
+            for (int id : res.hull) {
+                min_x = std::min(min_x, pts[id].x);
+                max_x = std::max(max_x, pts[id].x);
+                min_y = std::min(min_y, pts[id].y);
+                max_y = std::max(max_y, pts[id].y);
+            }
+            const double diag = std::hypot(static_cast<double>(max_x) - min_x, static_cast<double>(max_y) - min_y);
+            if (diag > 0.0) report_check(HullVerifier(res.error / diag), pts, res.hull);
+        }
+        return 0;
+    }
+
+    if (mode == 12) {
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 1;
+        std::cin >> gen_index;
+        std::cout << "points\n";
+        std::size_t n = 10000000;
+        std::cin >> n;
+        std::cout << "runs\n";
+        int runs = 5;
+        std::cin >> runs;
+
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        std::vector<core::Point> pts = cached_input(cache, *genSpecs[gen_index - 1].make(), n, 2000.0f, 1200.0f);
+
+        using Inlined = HullPipeline<pipeline::AklToussaint, pipeline::ComparisonSort<>, pipeline::MonotoneChain<>>;
+        using Erased = HullPipeline<pipeline::ErasedPrefilter<pipeline::AklToussaint>,
+                                    pipeline::ComparisonSort<pipeline::ErasedLess>,
+                                    pipeline::MonotoneChain<pipeline::ErasedTurn>>;
+        using Radix = HullPipeline<pipeline::AklToussaint, pipeline::RadixSort, pipeline::MonotoneChain<>>;
+        using Unfiltered = HullPipeline<pipeline::KeepAll, pipeline::ComparisonSort<>, pipeline::MonotoneChain<>>;
+
+        Inlined inlined;
+        Erased erased({}, {pipeline::LessXY{}}, {pipeline::Orient{}});
+        Radix radix;
+        Unfiltered unfiltered;
+        PipelineAlgorithm<Inlined> adapted;
+        adapted.reset(pts);
+
+        // best of the runs for each, the same input every time
+        auto best_of = [&](auto&& run) {
+            long long best = 0;
+            std::vector<int> hull;
+            for (int r = 0; r < std::max(1, runs); ++r) {
+                Stopwatch sw;
+                sw.start();
+                hull = run();
+                sw.stop();
+                if (r == 0 || sw.ns() < best) best = sw.ns();
+            }
+            return std::make_pair(best, hull);
+        };
+        const auto [inlined_ns, hull] = best_of([&] { return inlined.run(pts); });
+        const auto [erased_ns, erased_hull] = best_of([&] { return erased.run(pts); });
+        const auto [radix_ns, radix_hull] = best_of([&] { return radix.run(pts); });
+        const auto [unfiltered_ns, unfiltered_hull] = best_of([&] { return unfiltered.run(pts); });
+        const auto [adapted_ns, adapted_hull] = best_of([&] { return static_cast<ConvexHullAlgorithm&>(adapted).run_full(); });
+
+        std::cout << "Prefilter kept " << inlined.kept() << " of " << pts.size() << " points" << std::endl;
+        auto line = [&](const std::string& label, long long ns, const std::vector<int>& h) {
+            std::cout << label << ": " << ns << "ns, " << static_cast<double>(erased_ns) / std::max(1LL, ns)
+                      << "x the erased stages, hull size: " << h.size() << std::endl;
+        };
+        line(Inlined::name(), inlined_ns, hull);
+        line(Inlined::name() + ", erased stages", erased_ns, erased_hull);
+        line(Radix::name(), radix_ns, radix_hull);
+        line(Unfiltered::name(), unfiltered_ns, unfiltered_hull);
+        line(Inlined::name() + ", through ConvexHullAlgorithm", adapted_ns, adapted_hull);
+        // repeated positions may leave different ids, so only sizes compare
+        for (const std::vector<int>* other : {&erased_hull, &radix_hull, &unfiltered_hull, &adapted_hull}) {
+            if (other->size() != hull.size()) std::cout << "  pipelines disagree on the hull size" << std::endl;
+        }
+        report_check(verifier, pts, hull);
+        return 0;
+    }
+
+    if (mode == 13) {
+        std::cout << "generator, 1 to " << genSpecs.size() << "\n";
+        std::size_t gen_index = 2;
+        std::cin >> gen_index;
+        std::cout << "points\n";
+        std::size_t n = 1000000;
+        std::cin >> n;
+        std::cout << "hulls in the batch, each over a tile of the points\n";
+        std::size_t tiles = 1024;
+        std::cin >> tiles;
+
+        gen_index = std::clamp<std::size_t>(gen_index, 1, genSpecs.size());
+        std::vector<core::Point> pts = cached_input(cache, *genSpecs[gen_index - 1].make(), n, 2000.0f, 1200.0f);
+        AndrewAlgorithm andrew;
+        andrew.reset(pts);
+        const std::vector<int> hull = andrew.run_full();
+
+        Stopwatch calipers_sw;
+        calipers_sw.start();
+        const HullMetrics fast = hull_metrics(pts, hull);
+        calipers_sw.stop();
+        Stopwatch naive_sw;
+        naive_sw.start();
+        const HullMetrics naive = hull_metrics_naive(pts, hull);
+        naive_sw.stop();
+        std::cout << "Hull size: " << hull.size() << ", calipers: " << calipers_sw.ns() << "ns, naive: " << naive_sw.ns() << "ns" << std::endl;
+        std::cout << "  diameter " << fast.diameter << " (naive " << naive.diameter << "), width " << fast.width
+                  << " (" << naive.width << ")" << std::endl;
+        std::cout << "  min area rectangle " << fast.min_area.area << " (" << naive.min_area.area
+                  << "), min perimeter rectangle " << fast.min_perimeter.perimeter << " (" << naive.min_perimeter.perimeter << ")" << std::endl;
+
+        // contiguous slices of the input, each with its own hull, ids kept global
+        tiles = std::clamp<std::size_t>(tiles, 1, std::max<std::size_t>(1, pts.size()));
+        std::vector<std::vector<int>> hulls(tiles);
+        for (std::size_t k = 0; k < tiles; ++k) {
+            const std::size_t begin = pts.size() * k / tiles;
+            const std::size_t end = pts.size() * (k + 1) / tiles;
+            AndrewAlgorithm tile;
+            tile.reset(std::vector<core::Point>(pts.begin() + begin, pts.begin() + end));
+            hulls[k] = tile.run_full();
+            for (int& id : hulls[k]) id += static_cast<int>(begin);
+        }
+        Stopwatch batch_sw;
+        batch_sw.start();
+        const std::vector<HullMetrics> batch = hull_metrics(pts, hulls);
+        batch_sw.stop();
+        Stopwatch batch_naive_sw;
+        batch_naive_sw.start();
+        std::size_t mismatches = 0;
+        for (std::size_t k = 0; k < tiles; ++k) {
+            const HullMetrics ref = hull_metrics_naive(pts, hulls[k]);
+            mismatches += std::fabs(ref.diameter - batch[k].diameter) > 1e-9 * std::max(1.0, ref.diameter) ? 1 : 0;
+        }
+        batch_naive_sw.stop();
+        std::cout << "Batch of " << tiles << " hulls, calipers: " << batch_sw.ns() << "ns, naive: " << batch_naive_sw.ns()
+                  << "ns, diameters differing: " << mismatches << std::endl;
         return 0;
     }
 
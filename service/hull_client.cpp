@@ -0,0 +1,112 @@
+#include "service/hull_client.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace service {
+    using distributed::MessageHeader;
+    using distributed::MessageKind;
+    using distributed::WireVertex;
+
+    SharedPointSet::SharedPointSet(std::string name, const std::vector<core::Point>& pts)
+        : name_(std::move(name)), count_(pts.size()) {
+        const int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) throw std::runtime_error("cannot create shared memory " + name_ + ": " + std::strerror(errno));
+        const std::size_t bytes = count_ * sizeof(WireVertex);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            throw std::runtime_error("cannot size shared memory " + name_);
+        }
+        if (bytes > 0) {
+            void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                ::shm_unlink(name_.c_str());
+                throw std::runtime_error("cannot map shared memory " + name_);
+            }
+            auto* v = static_cast<WireVertex*>(map);
+            for (std::size_t i = 0; i < count_; ++i) v[i] = WireVertex{pts[i].x, pts[i].y, pts[i].id};
+            ::munmap(map, bytes);
+        }
+        ::close(fd);
+    }
+
+    SharedPointSet::~SharedPointSet() {
+        ::shm_unlink(name_.c_str());
+    }
+
+    HullClient::HullClient(const std::string& socket_path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (socket_path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("socket path too long");
+        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("cannot connect to " + socket_path + ": " + std::strerror(errno));
+        }
+    }
+
+    HullClient::~HullClient() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    std::vector<char> HullClient::exchange(const MessageHeader& req, const void* payload, MessageHeader& rep) {
+        distributed::send_message(fd_, req, payload);
+        std::vector<char> body;
+        if (!distributed::recv_header(fd_, rep) || !distributed::recv_payload(fd_, rep, body)) {
+            throw std::runtime_error("hull service closed the connection");
+        }
+        if (rep.kind == MessageKind::Error) throw std::runtime_error("hull service: " + std::string(body.begin(), body.end()));
+        return body;
+    }
+
+    std::vector<int> HullClient::indices(const MessageHeader& rep, const std::vector<char>& payload) {
+        if (rep.kind != MessageKind::HullIndices) throw std::runtime_error("unexpected reply kind");
+        if (rep.count > payload.size() / sizeof(std::int32_t)) {
+            throw std::runtime_error("hull reply of " + std::to_string(payload.size()) + " bytes is short of " +
+                                     std::to_string(rep.count) + " indices");
+        }
+        std::vector<int> out(static_cast<std::size_t>(rep.count));
+        std::memcpy(out.data(), payload.data(), out.size() * sizeof(std::int32_t));
+        return out;
+    }
+
+    std::vector<int> HullClient::hull(const std::vector<core::Point>& pts) {
+        std::vector<WireVertex> verts = distributed::to_wire(pts);
+        MessageHeader req{};
+        req.kind = MessageKind::InlinePoints;
+        req.count = verts.size();
+        req.payload_bytes = verts.size() * sizeof(WireVertex);
+        MessageHeader rep{};
+        std::vector<char> body = exchange(req, verts.data(), rep);
+        return indices(rep, body);
+    }
+
+    std::vector<int> HullClient::hull(const SharedPointSet& shared) {
+        MessageHeader req{};
+        req.kind = MessageKind::ShmPoints;
+        req.count = shared.size();
+        req.payload_bytes = shared.name().size();
+        MessageHeader rep{};
+        std::vector<char> body = exchange(req, shared.name().data(), rep);
+        return indices(rep, body);
+    }
+
+    std::string HullClient::stats() {
+        MessageHeader req{};
+        req.kind = MessageKind::Stats;
+        MessageHeader rep{};
+        std::vector<char> body = exchange(req, nullptr, rep);
+        return std::string(body.begin(), body.end());
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef SERVICE_HULL_CLIENT_H
+#define SERVICE_HULL_CLIENT_H
+
+#include <string>
+#include <vector>
+#include "core/types.h"
+#include "distributed/wire.h"
+
+namespace service {
+    // points placed in a posix shared memory segment, a request naming it
+    // skips the socket and the service copies the points once, straight into
+    // its algorithm's input. the segment is unlinked when this goes away
+    class SharedPointSet {
+    public:
+        SharedPointSet(std::string name, const std::vector<core::Point>& pts);
+        ~SharedPointSet();
+        SharedPointSet(const SharedPointSet&) = delete;
+        SharedPointSet& operator=(const SharedPointSet&) = delete;
+
+        const std::string& name() const { return name_; }
+        std::size_t size() const { return count_; }
+
+    private:
+        std::string name_;
+        std::size_t count_{0};
+    };
+
+    // blocking client for HullService, one request in flight per connection
+    class HullClient {
+    public:
+        explicit HullClient(const std::string& socket_path);
+        ~HullClient();
+        HullClient(const HullClient&) = delete;
+        HullClient& operator=(const HullClient&) = delete;
+
+        // hull indices into pts in CCW order
+        std::vector<int> hull(const std::vector<core::Point>& pts);
+        std::vector<int> hull(const SharedPointSet& shared);
+
+        std::string stats();
+
+    private:
+        int fd_{-1};
+
+        std::vector<char> exchange(const distributed::MessageHeader& req, const void* payload,
+                                   distributed::MessageHeader& rep);
+        static std::vector<int> indices(const distributed::MessageHeader& rep, const std::vector<char>& payload);
+    };
+}
+
+#endif
@@ -0,0 +1,413 @@
+#include "service/hull_service.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace service {
+    using distributed::MessageHeader;
+    using distributed::MessageKind;
+    using distributed::WireVertex;
+
+    HullService::HullService(AlgoFactory make, HullServiceConfig cfg)
+        : make_(std::move(make)), cfg_(std::move(cfg)) {
+        if (!make_) throw std::runtime_error("hull service needs an algorithm");
+        if (cfg_.workers < 1) cfg_.workers = 1;
+    }
+
+    HullService::~HullService() {
+        if (listen_fd_ >= 0) ::close(listen_fd_);
+        if (wake_[0] >= 0) ::close(wake_[0]);
+        if (wake_[1] >= 0) ::close(wake_[1]);
+    }
+
+    void HullService::stop() {
+        stop_requested_.store(true);
+        wake();
+    }
+
+    void HullService::wake() const {
+        if (wake_[1] < 0) return;
+        const char b = 1;
+        [[maybe_unused]] ssize_t r = ::write(wake_[1], &b, 1);
+    }
+
+    std::string HullService::stats_text() const {
+        const double secs = std::chrono::duration<double>(SteadyClock::now() - started_).count();
+        const std::uint64_t req = requests_.load();
+        std::ostringstream ss;
+        ss << "requests " << req << "\n";
+        ss << "points " << points_.load() << "\n";
+        ss << "batches " << batches_.load() << "\n";
+        ss << "throughput " << std::fixed << std::setprecision(1)
+           << (secs > 0.0 ? static_cast<double>(req) / secs : 0.0) << " req/s\n";
+        ss << "latency p50 " << latency_.percentile(0.50) / 1000 << " us\n";
+        ss << "latency p99 " << latency_.percentile(0.99) / 1000 << " us\n";
+        return ss.str();
+    }
+
+    std::vector<core::Point> HullService::load_points(const Job& job) {
+        // ids are ints, and a shared memory count is only checked against
+        // the segment below, after which the points are allocated
+        if (job.header.count > static_cast<std::uint64_t>(INT_MAX) + 1) throw std::runtime_error("too many points for int ids");
+        const auto n = static_cast<std::size_t>(job.header.count);
+
+        if (job.header.kind == MessageKind::InlinePoints) {
+            std::vector<core::Point> pts(n);
+            if (job.payload.size() < n * sizeof(WireVertex)) throw std::runtime_error("short point payload");
+            const auto* v = reinterpret_cast<const WireVertex*>(job.payload.data());
+            for (std::size_t i = 0; i < n; ++i) pts[i] = core::Point{v[i].x, v[i].y, static_cast<int>(i)};
+            return pts;
+        }
+
+        // shared memory input, the points never cross the socket. this is
+        // their one copy, reset takes the array over
+        const std::string name(job.payload.begin(), job.payload.end());
+        const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) throw std::runtime_error("cannot open shared memory " + name + ": " + std::strerror(errno));
+        struct stat st{};
+        const std::size_t bytes = n * sizeof(WireVertex);
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < bytes) {
+            ::close(fd);
+            throw std::runtime_error("shared memory " + name + " is smaller than the point count");
+        }
+        void* map = bytes > 0 ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+        ::close(fd);
+        if (map == MAP_FAILED) throw std::runtime_error("cannot map shared memory " + name);
+
+        std::vector<core::Point> pts(n);
+        const auto* v = static_cast<const WireVertex*>(map);
+        for (std::size_t i = 0; i < n; ++i) pts[i] = core::Point{v[i].x, v[i].y, static_cast<int>(i)};
+        if (map) ::munmap(map, bytes);
+        return pts;
+    }
+
+    void HullService::handle(Job& job, ConvexHullAlgorithm& algo) {
+        MessageHeader rep{};
+        rep.shard = job.header.shard;
+        std::vector<std::int32_t> ids;
+        std::string error;
+        try {
+            std::vector<core::Point> pts = load_points(job);
+            const std::size_t n = pts.size();
+            algo.reset(std::move(pts));
+            std::vector<int> hull = algo.run_cancellable(job.cancel.get_token());
+            ids.assign(hull.begin(), hull.end());
+            points_.fetch_add(n, std::memory_order_relaxed);
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        // counted before the reply so a client never sees stats that miss its request
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - job.arrived).count();
+        latency_.record(static_cast<std::uint64_t>(ns));
+        requests_.fetch_add(1, std::memory_order_relaxed);
+
+        bool ok = true;
+        try {
+            if (error.empty()) {
+                rep.kind = MessageKind::HullIndices;
+                rep.count = ids.size();
+                rep.payload_bytes = ids.size() * sizeof(std::int32_t);
+                send_reply(job.fd, rep, ids.data());
+            } else {
+                rep.kind = MessageKind::Error;
+                rep.payload_bytes = error.size();
+                send_reply(job.fd, rep, error.data());
+            }
+        } catch (const std::exception&) {
+            ok = false; // client went away or stopped reading
+        }
+
+        finish(job.fd, ok);
+    }
+
+    void HullService::finish(int fd, bool ok) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (ok) rearm_.push_back(fd);
+            else dropped_.push_back(fd);
+        }
+        wake();
+    }
+
+    void HullService::worker_loop() {
+        std::unique_ptr<ConvexHullAlgorithm> algo = make_();
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                // one at a time, so an idle worker always finds the next request
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            handle(job, *algo);
+        }
+    }
+
+    namespace {
+        // a client connection and its partly read request
+        struct Conn {
+            MessageHeader header{};
+            std::size_t header_got{0};
+            std::vector<char> payload;
+            std::size_t payload_got{0};
+            bool busy{false};      // a request in flight
+            std::stop_source run;  // its run, while busy
+        };
+
+        enum class ReadState { More, Done, Closed };
+
+        // longest shared memory name taken, as NAME_MAX
+        constexpr std::uint64_t kMaxShmName = 255;
+
+        // whether a request of this kind may carry payload_bytes, checked
+        // before anything is allocated for it
+        bool payload_fits(const MessageHeader& h, std::uint64_t max_payload) {
+            switch (h.kind) {
+            case MessageKind::Stats:
+                return h.payload_bytes == 0;
+            case MessageKind::InlinePoints:
+                return h.payload_bytes <= max_payload && h.payload_bytes % sizeof(WireVertex) == 0 &&
+                       h.payload_bytes / sizeof(WireVertex) == h.count;
+            case MessageKind::ShmPoints:
+                return h.payload_bytes > 0 && h.payload_bytes <= kMaxShmName;
+            default:
+                return false;
+            }
+        }
+
+        // reads what the socket holds of the next request without blocking.
+        // a header whose payload does not fit its kind closes the connection
+        ReadState read_request(int fd, Conn& c, std::uint64_t max_payload) {
+            while (true) {
+                char* dst;
+                std::size_t want;
+                if (c.header_got < sizeof(c.header)) {
+                    dst = reinterpret_cast<char*>(&c.header) + c.header_got;
+                    want = sizeof(c.header) - c.header_got;
+                } else {
+                    dst = c.payload.data() + c.payload_got;
+                    want = c.payload.size() - c.payload_got;
+                }
+                if (want == 0) return ReadState::Done;
+
+                const ssize_t got = ::recv(fd, dst, want, 0);
+                if (got < 0 && errno == EINTR) continue;
+                if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return ReadState::More;
+                if (got <= 0) return ReadState::Closed;
+
+                if (c.header_got < sizeof(c.header)) {
+                    c.header_got += static_cast<std::size_t>(got);
+                    if (c.header_got == sizeof(c.header)) {
+                        if (c.header.magic != distributed::kWireMagic) return ReadState::Closed;
+                        if (!payload_fits(c.header, max_payload)) return ReadState::Closed;
+                        c.payload.resize(static_cast<std::size_t>(c.header.payload_bytes));
+                        c.payload_got = 0;
+                    }
+                } else {
+                    c.payload_got += static_cast<std::size_t>(got);
+                }
+            }
+        }
+    }
+
+    void HullService::send_reply(int fd, const MessageHeader& header, const void* payload) {
+        auto put = [fd](const void* data, std::size_t bytes) {
+            const auto* p = static_cast<const char*>(data);
+            while (bytes > 0) {
+                const ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);
+                if (n > 0) {
+                    p += n;
+                    bytes -= static_cast<std::size_t>(n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) continue;
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    // the socket is non blocking, a client that stops reading
+                    // holds up this worker only until the timeout
+                    pollfd pfd{fd, POLLOUT, 0};
+                    const int r = ::poll(&pfd, 1, kReplyTimeoutMs);
+                    if (r > 0 || (r < 0 && errno == EINTR)) continue;
+                    throw std::runtime_error("reply timed out");
+                }
+                throw std::runtime_error(std::string("send failed: ") + std::strerror(errno));
+            }
+        };
+        put(&header, sizeof(header));
+        if (header.payload_bytes > 0) put(payload, static_cast<std::size_t>(header.payload_bytes));
+    }
+
+    void HullService::io_loop() {
+        std::unordered_map<int, Conn> conns;
+        std::vector<pollfd> fds;
+        std::vector<char> drain(256);
+        std::vector<Job> arrived; // requests read in one round, queued together
+
+        auto close_conn = [&](int fd) {
+            ::close(fd);
+            conns.erase(fd);
+        };
+
+        while (!stop_requested_.load()) {
+            fds.clear();
+            fds.push_back(pollfd{wake_[0], POLLIN, 0});
+            fds.push_back(pollfd{listen_fd_, POLLIN, 0});
+            for (auto& [fd, c] : conns) {
+                // a busy one asks for no events, poll still reports a hang up.
+                // one already cancelled is left out, it would report the same again
+                if (!c.busy) fds.push_back(pollfd{fd, POLLIN, 0});
+                else if (!c.run.stop_requested()) fds.push_back(pollfd{fd, 0, 0});
+            }
+
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+            }
+
+            if (fds[0].revents & POLLIN) {
+                [[maybe_unused]] ssize_t r = ::read(wake_[0], drain.data(), drain.size());
+                std::lock_guard<std::mutex> lock(mu_);
+                for (int fd : rearm_) {
+                    const auto it = conns.find(fd);
+                    if (it != conns.end()) it->second = Conn{};
+                }
+                for (int fd : dropped_) close_conn(fd);
+                rearm_.clear();
+                dropped_.clear();
+            }
+
+            if (fds[1].revents & POLLIN) {
+                const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd >= 0) conns.emplace(fd, Conn{});
+            }
+
+            for (std::size_t k = 2; k < fds.size(); ++k) {
+                if (!fds[k].revents) continue;
+                const int fd = fds[k].fd;
+                const auto it = conns.find(fd);
+                if (it == conns.end()) continue; // dropped in this round
+                Conn& c = it->second;
+
+                if (c.busy) {
+                    // the client gave up on its request, the reply will fail
+                    // and the connection is closed as dropped. one answered
+                    // just now is idle already
+                    c.run.request_stop();
+                    continue;
+                }
+
+                const ReadState state = read_request(fd, c, cfg_.max_payload_bytes);
+                if (state == ReadState::Closed) {
+                    close_conn(fd);
+                    continue;
+                }
+                if (state == ReadState::More) continue;
+
+                if (c.header.kind == MessageKind::Stats) {
+                    // answered right here, it never waits behind hull work. a
+                    // client that cannot take a few hundred bytes is dropped
+                    const std::string text = stats_text();
+                    MessageHeader rep{};
+                    rep.kind = MessageKind::Stats;
+                    rep.payload_bytes = text.size();
+                    try {
+                        distributed::send_message(fd, rep, text.data());
+                        c = Conn{};
+                    } catch (const std::exception&) {
+                        close_conn(fd);
+                    }
+                    continue;
+                }
+                if (c.header.kind != MessageKind::InlinePoints && c.header.kind != MessageKind::ShmPoints) {
+                    close_conn(fd);
+                    continue;
+                }
+
+                Job job;
+                job.fd = fd;
+                job.header = c.header;
+                job.payload = std::move(c.payload);
+                job.arrived = SteadyClock::now();
+                c.busy = true;
+                c.run = job.cancel;
+                arrived.push_back(std::move(job));
+            }
+
+            if (!arrived.empty()) {
+                {
+                    std::lock_guard<std::mutex> lock(mu_);
+                    for (Job& job : arrived) queue_.push_back(std::move(job));
+                }
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                for (std::size_t i = 0; i < arrived.size(); ++i) cv_.notify_one();
+                arrived.clear();
+            }
+        }
+
+        // queued and running requests fail fast with a cancelled error
+        for (auto& [fd, c] : conns) {
+            if (c.busy) c.run.request_stop();
+        }
+        stop_workers();
+
+        // replies are all out once the workers joined
+        for (auto& [fd, c] : conns) ::close(fd);
+    }
+
+    void HullService::stop_workers() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread& t : workers_) t.join();
+        workers_.clear();
+    }
+
+    void HullService::run() {
+        if (::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0) {
+            throw std::runtime_error(std::string("pipe failed: ") + std::strerror(errno));
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (cfg_.socket_path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("socket path too long");
+        std::strncpy(addr.sun_path, cfg_.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+        ::unlink(cfg_.socket_path.c_str());
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listen_fd_, 128) != 0) {
+            throw std::runtime_error("cannot listen on " + cfg_.socket_path + ": " + std::strerror(errno));
+        }
+
+        started_ = SteadyClock::now();
+        stopping_ = false;
+        for (int i = 0; i < cfg_.workers; ++i) workers_.emplace_back([this] { worker_loop(); });
+
+        try {
+            io_loop();
+        } catch (...) {
+            stop_workers();
+            throw;
+        }
+
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        ::unlink(cfg_.socket_path.c_str());
+    }
+}
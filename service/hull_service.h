@@ -0,0 +1,97 @@
+#ifndef SERVICE_HULL_SERVICE_H
+#define SERVICE_HULL_SERVICE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "distributed/wire.h"
+#include "service/latency_histogram.h"
+
+namespace service {
+    struct HullServiceConfig {
+        std::string socket_path{"/tmp/convex_hull.sock"};
+        int workers{4};
+        std::uint64_t max_payload_bytes{std::uint64_t{1} << 30}; // largest inline request, larger ones are hung up on
+    };
+
+    // long running hull daemon on a unix domain socket. one io thread accepts
+    // connections and reads requests off non blocking sockets, buffering a
+    // partly sent one per connection. the ones read in one round go onto a
+    // shared queue together. a pool of workers takes them off one at a time
+    // and replies with hull indices. every connection has at most one request
+    // in flight, its socket is only watched for a hang up until the reply is
+    // out. a hang up, or stop, cancels the run at its next checkpoint
+    class HullService {
+    public:
+        using AlgoFactory = std::function<std::unique_ptr<ConvexHullAlgorithm>()>;
+
+        HullService(AlgoFactory make, HullServiceConfig cfg);
+        ~HullService();
+        HullService(const HullService&) = delete;
+        HullService& operator=(const HullService&) = delete;
+
+        // serve until stop is called
+        void run();
+
+        // safe to call from a signal handler
+        void stop();
+
+        std::string stats_text() const;
+
+    private:
+        using SteadyClock = std::chrono::steady_clock;
+
+        static constexpr int kReplyTimeoutMs = 5000;
+
+        struct Job {
+            int fd{-1};
+            distributed::MessageHeader header{};
+            std::vector<char> payload;
+            SteadyClock::time_point arrived{};
+            std::stop_source cancel;
+        };
+
+        AlgoFactory make_;
+        HullServiceConfig cfg_;
+
+        int listen_fd_{-1};
+        int wake_[2]{-1, -1};
+        std::atomic<bool> stop_requested_{false};
+
+        std::mutex mu_;
+        std::condition_variable cv_;
+        std::deque<Job> queue_;
+        std::vector<int> rearm_;  // connections whose reply went out, to be polled again
+        std::vector<int> dropped_; // connections a worker failed to answer
+        bool stopping_{false};
+        std::vector<std::thread> workers_;
+
+        LatencyHistogram latency_;
+        std::atomic<std::uint64_t> requests_{0};
+        std::atomic<std::uint64_t> points_{0};
+        std::atomic<std::uint64_t> batches_{0}; // rounds that queued requests
+        SteadyClock::time_point started_{};
+
+        void io_loop();
+        void worker_loop();
+        void stop_workers();
+        void handle(Job& job, ConvexHullAlgorithm& algo);
+        void finish(int fd, bool ok);
+        // full reply on a non blocking socket, waits for room up to kReplyTimeoutMs
+        static void send_reply(int fd, const distributed::MessageHeader& header, const void* payload);
+        void wake() const;
+
+        static std::vector<core::Point> load_points(const Job& job);
+    };
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include "service/latency_histogram.h"
+#include <bit>
+
+int LatencyHistogram::bucket_of(std::uint64_t ns) {
+    if (ns < kSub) return static_cast<int>(ns);
+    const int e = 63 - std::countl_zero(ns); // e >= 4
+    const int sub = static_cast<int>((ns >> (e - 4)) & (kSub - 1));
+    return (e - 3) * kSub + sub;
+}
+
+std::uint64_t LatencyHistogram::lower_bound_of(int bucket) {
+    if (bucket < kSub) return static_cast<std::uint64_t>(bucket);
+    const int e = bucket / kSub + 3;
+    const int sub = bucket % kSub;
+    return static_cast<std::uint64_t>(kSub + sub) << (e - 4);
+}
+
+void LatencyHistogram::record(std::uint64_t ns) {
+    buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    std::uint64_t total = 0;
+    for (const auto& b : buckets_) total += b.load(std::memory_order_relaxed);
+    return total;
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const {
+    const std::uint64_t total = count();
+    if (total == 0) return 0;
+    auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+    if (rank >= total) rank = total - 1;
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen > rank) return lower_bound_of(i);
+    }
+    return lower_bound_of(kBuckets - 1);
+}
@@ -0,0 +1,30 @@
+#ifndef SERVICE_LATENCY_HISTOGRAM_H
+#define SERVICE_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// lock free log linear histogram of nanosecond latencies. values below 16
+// get their own bucket, above that every power of two is split into 16
+// buckets, so a percentile is accurate to about 6 percent
+class LatencyHistogram {
+public:
+    void record(std::uint64_t ns);
+
+    std::uint64_t count() const;
+
+    // lower bound of the bucket holding the q quantile, q in [0, 1]
+    std::uint64_t percentile(double q) const;
+
+private:
+    static constexpr int kSub = 16;
+    static constexpr int kBuckets = (64 - 3) * kSub;
+
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+
+    static int bucket_of(std::uint64_t ns);
+    static std::uint64_t lower_bound_of(int bucket);
+};
+
+#endif
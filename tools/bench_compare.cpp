@@ -0,0 +1,74 @@
+#include "bench/compare.h"
+#include "bench/results.h"
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// compares a benchmark run against the baseline of this machine, both as
+// written by the perf mode, and exits 1 on a significant slowdown past the
+// threshold, 2 on bad input
+//
+//   bench_compare [--baseline file] [--current file] [--threshold percent]
+//                 [--alpha level] [--accept]
+//
+// --accept makes the current run the new baseline after the comparison
+static void usage() {
+    std::cerr << "usage: bench_compare [--baseline file] [--current file] [--threshold percent] [--alpha level] [--accept]\n";
+}
+
+int main(int argc, char** argv) {
+    const std::string machine = bench::machine_name();
+    std::string baseline = bench::baseline_path(machine);
+    std::string current = bench::latest_path(machine);
+    bench::CompareOptions opt;
+    bool accept = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " needs a value");
+                return argv[++i];
+            };
+            if (arg == "--baseline") baseline = value();
+            else if (arg == "--current") current = value();
+            else if (arg == "--threshold") opt.threshold = std::stod(value()) / 100.0;
+            else if (arg == "--alpha") opt.alpha = std::stod(value());
+            else if (arg == "--accept") accept = true;
+            else throw std::runtime_error("unknown argument " + arg);
+        }
+        if (!(opt.alpha > 0.0 && opt.alpha < 1.0)) throw std::runtime_error("alpha must be in (0, 1)");
+        if (!(opt.threshold >= 0.0)) throw std::runtime_error("threshold must not be negative");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        usage();
+        return 2;
+    }
+
+    try {
+        const std::vector<bench::Sample> base = bench::read_results(baseline);
+        const std::vector<bench::Sample> now = bench::read_results(current);
+        std::cout << "baseline " << baseline << ", " << base.size() << " runs\n";
+        std::cout << "current  " << current << ", " << now.size() << " runs\n\n";
+
+        const std::vector<bench::Comparison> rows = bench::compare(base, now, opt);
+        bench::print_table(std::cout, rows, opt);
+
+        std::size_t regressions = 0;
+        for (const bench::Comparison& r : rows) regressions += r.regression ? 1 : 0;
+
+        if (accept) {
+            std::filesystem::copy_file(current, baseline, std::filesystem::copy_options::overwrite_existing);
+            std::cout << "current run is the new baseline\n";
+        }
+        if (regressions > 0) {
+            std::cout << regressions << " regression" << (regressions == 1 ? "" : "s") << "\n";
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}
@@ -1,7 +1,11 @@
 #include "visualizer/app.h"
+#include "core/stopwatch.h"
 #include <algorithm>
 #include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 
 using SteadyClock = std::chrono::steady_clock;
@@ -26,47 +30,137 @@ App::App(std::vector<AlgoSpec> algoSpecs, std::vector<GenSpec> genSpecs)
 
     active_index_ = 0;
     active_gen_index_ = 0;
-    active_ = specs_[active_index_].make();
 }
 
 void App::regen_flow() {
     auto gen = gens_[active_gen_index_].make();
-    points = gen->generate(50,
-                           static_cast<float>(WIN_W),
-                           static_cast<float>(WIN_H));
+    const std::size_t n = POINT_COUNTS[point_count_index_];
+    const auto w = static_cast<float>(WIN_W);
+    const auto h = static_cast<float>(WIN_H);
+    if (n >= CACHE_MIN) {
+        const io::InputKey key{gen->name(), w, h, draw_, n};
+        points = cache_.points(key, [&] { return gen->generate(n, w, h); }, &input_key_);
+    } else {
+        input_key_ = 0;
+        points = gen->generate(n, w, h);
+    }
     have_data = !points.empty();
+    renderer.set_points(points);
 }
 
 void App::select_algo(int index, bool stop_play) {
     if (index < 0 || index >= static_cast<int>(specs_.size())) return;
     active_index_ = index;
-    restart_active(stop_play, true);
+    restart_active(stop_play);
 }
 
 void App::select_gen(int index) {
     if (index < 0 || index >= static_cast<int>(gens_.size())) return;
     active_gen_index_ = index;
     regen_flow();
-    restart_active(true, true);
+    restart_active(true);
 }
 
-void App::restart_active(bool stop_play, bool recreate_instance) {
+void App::select_point_count(int index) {
+    const int count = static_cast<int>(std::size(POINT_COUNTS));
+    index = std::clamp(index, 0, count - 1);
+    if (index == point_count_index_) return;
+    point_count_index_ = index;
+    regen_flow();
+    restart_active(true);
+}
+
+void App::restart_active(bool stop_play) {
     if (stop_play) renderer.set_play(false);
-    if (!have_data) return;
-    if (recreate_instance) {
-        active_ = specs_[active_index_].make();
+    retire_worker();
+    if (race_) {
+        race_->cancel();
+        retired_races_.push_back(std::move(race_));
     }
-    active_->reset(points);
-    active_->begin_stepping();
     last_run_ms = 0.0;
     step_accum_ms_ = 0.0;
+    frame_ = core::HullFrame{};
+    have_frame_ = false;
+    if (!have_data) return;
+
+    stepping_ = points.size() <= STEP_LIMIT;
+    if (!stepping_) renderer.set_play(false);
+    if (race_on_) {
+        start_race();
+        return;
+    }
+    compute_start_ = SteadyClock::now();
+    worker_ = std::make_unique<StepWorker>(specs_[active_index_].make(), points, stepping_, &cache_, input_key_);
+    update_progress();
+}
+
+void App::retire_worker() {
+    if (!worker_) return;
+    worker_->cancel();
+    retired_.push_back(std::move(worker_));
+}
+
+void App::start_race() {
+    std::vector<Race::Entry> entries;
+    entries.reserve(specs_.size());
+    for (std::size_t i = 0; i < specs_.size(); ++i) entries.push_back({algo_names_[i], specs_[i].make});
+
+    // the background runs use the same generator at a larger n
+    std::size_t big_n = std::clamp(points.size() * 10, RACE_BIG_MIN, RACE_BIG_MAX);
+    if (big_n <= points.size()) big_n = 0;
+    Race::PointSource source = [this, make = gens_[active_gen_index_].make, draw = draw_](std::size_t n) {
+        auto gen = make();
+        const auto w = static_cast<float>(WIN_W);
+        const auto h = static_cast<float>(WIN_H);
+        return cache_.points(io::InputKey{gen->name(), w, h, draw, n}, [&] { return gen->generate(n, w, h); });
+    };
+    race_ = std::make_unique<Race>(std::move(entries), points, stepping_, std::move(source), big_n);
+}
+
+// one step in whatever is on screen, false when nothing new was ready
+bool App::advance() {
+    if (race_) return race_->advance();
+    return next_frame();
+}
+
+bool App::stream_drained() const {
+    if (race_) return race_->drained();
+    return !worker_ || worker_->drained();
+}
+
+// take the next frame from the worker, false when none is ready yet or the
+// stream is over
+bool App::next_frame() {
+    if (!worker_) return false;
+    core::HullFrame fr;
+    if (!worker_->pop(fr)) return false;
+    frame_ = std::move(fr);
+    if (!have_frame_) {
+        have_frame_ = true;
+        if (!stepping_) {
+            last_run_ms = worker_->run_ms();
+            frame_.label += ", stepping is off above " + std::to_string(STEP_LIMIT) + " points";
+        }
+    }
+    return true;
+}
+
+// placeholder status while the worker is still computing the first frame
+void App::update_progress() {
+    if (have_frame_ || !worker_) return;
+    const double secs = std::chrono::duration<double>(SteadyClock::now() - compute_start_).count();
+    static const char* spinner[] = {"|", "/", "-", "\\"};
+    std::ostringstream os;
+    os << "Computing " << algo_names_[active_index_] << " on " << points.size() << " points  "
+       << spinner[static_cast<int>(secs * 8.0) % 4] << "  " << std::fixed << std::setprecision(1) << secs << " s";
+    frame_.label = os.str();
 }
 
 void App::run() {
     renderer.open(WIN_W, WIN_H, "Convex Hull Visual");
 
     regen_flow();
-    restart_active(true, false);
+    restart_active(true);
 
     tick_prev_ = SteadyClock::now();
 
@@ -74,6 +168,22 @@ void App::run() {
         renderer.poll();
         if (!renderer.is_open()) break;
 
+        // join workers that have returned since they were replaced
+        std::erase_if(retired_, [](const std::unique_ptr<StepWorker>& w) { return w->finished(); });
+        std::erase_if(retired_races_, [](const std::unique_ptr<Race>& r) { return r->finished(); });
+
+        if (race_) {
+            race_->poll_frames();
+        } else if (!have_frame_ && !next_frame()) {
+            update_progress();
+        }
+
+        if (renderer.wants_toggle_race()) {
+            race_on_ = !race_on_;
+            restart_active(true);
+            continue;
+        }
+
         auto now = SteadyClock::now();
         double dt_ms = std::chrono::duration<double, std::milli>(now - tick_prev_).count();
         tick_prev_ = now;
@@ -106,30 +216,45 @@ void App::run() {
             continue;
         }
 
+        if (renderer.wants_more_points()) {
+            select_point_count(point_count_index_ + 1);
+            continue;
+        }
+
+        if (renderer.wants_fewer_points()) {
+            select_point_count(point_count_index_ - 1);
+            continue;
+        }
+
         if (renderer.wants_reset()) {
-            restart_active(true, true);
+            restart_active(true);
             continue;
         }
 
         if (renderer.wants_regen()) {
+            ++draw_;
             regen_flow();
-            restart_active(true, true);
+            restart_active(true);
             continue;
         }
 
-        if (renderer.wants_step()) {
-            if (!active_->step()) {
+        if (!stepping_) renderer.set_play(false);
+
+        const bool ready = race_ || have_frame_;
+        if (stepping_ && ready && renderer.wants_step()) {
+            if (!advance() && stream_drained()) {
                 renderer.set_play(false);
             }
         }
 
-        if (renderer.is_playing()) {
+        if (renderer.is_playing() && ready) {
             step_accum_ms_ += dt_ms;
             const double interval = BASE_INTERVAL_MS / std::max(0.01f, speed_multiplier_);
             int safety = 0;
             while (step_accum_ms_ >= interval && safety < 20) {
-                if (!active_->step()) {
-                    renderer.set_play(false);
+                if (!advance()) {
+                    // either the end of the stream or the worker is behind
+                    if (stream_drained()) renderer.set_play(false);
                     step_accum_ms_ = 0.0;
                     break;
                 }
@@ -138,12 +263,17 @@ void App::run() {
             }
         }
 
+        if (race_) {
+            renderer.draw_race(points, race_->panels(), race_->big_n());
+            continue;
+        }
+
         renderer.draw_scene(points,
                             algo_names_,
                             active_index_,
                             gen_names_,
                             active_gen_index_,
-                            active_->frame(),
+                            frame_,
                             last_run_ms,
                             speed_multiplier_,
                             slomo_on_);
@@ -7,9 +7,12 @@
 #include <vector>
 #include <chrono>
 #include "visualizer/renderer.h"
+#include "visualizer/race.h"
+#include "visualizer/step_worker.h"
 #include "algorithms/convex_hull_algorithm.h"
 #include "core/types.h"
 #include "generators/point_generator.h"
+#include "io/hull_cache.h"
 
 struct AlgoSpec {
     std::function<std::unique_ptr<ConvexHullAlgorithm>()> make;
@@ -29,17 +32,48 @@ private:
     std::vector<AlgoSpec> specs_;
     std::vector<std::string> algo_names_;
     int active_index_{0};
-    std::unique_ptr<ConvexHullAlgorithm> active_;
 
     std::vector<GenSpec> gens_;
     std::vector<std::string> gen_names_;
     int active_gen_index_{0};
 
+    // generated inputs from this size up, and full mode hulls over them, go
+    // through the disk cache. declared before the workers and races, which
+    // use it until they are joined
+    io::HullCache cache_;
+    static constexpr std::size_t CACHE_MIN = 100000;
+    std::uint64_t input_key_{0}; // points_hash of the cached input on screen, 0 when not cached
+    std::uint64_t draw_{0};      // the seed of cached inputs, R moves on to a fresh draw
+
     Renderer renderer;
     std::vector<core::Point> points;
     double last_run_ms{0.0};
     bool have_data{false};
 
+    // point count presets, PageUp and PageDown walk through them
+    static constexpr std::size_t POINT_COUNTS[] = {50, 500, 5000, 50000, 500000, 1000000, 5000000, 10000000};
+    int point_count_index_{0};
+
+    // stepping keeps every frame in memory, above this the hull is computed
+    // in one go and only the result is shown
+    static constexpr std::size_t STEP_LIMIT = 5000;
+    bool stepping_{true};
+
+    // the active algorithm runs on worker_, the ui shows the last frame it
+    // popped. replaced workers are cancelled and joined once they return
+    std::unique_ptr<StepWorker> worker_;
+    std::vector<std::unique_ptr<StepWorker>> retired_;
+    core::HullFrame frame_;
+    bool have_frame_{false};
+    std::chrono::steady_clock::time_point compute_start_{};
+
+    // race mode runs every algorithm at once, see Race
+    bool race_on_{false};
+    std::unique_ptr<Race> race_;
+    std::vector<std::unique_ptr<Race>> retired_races_;
+    static constexpr std::size_t RACE_BIG_MIN = 1000000;
+    static constexpr std::size_t RACE_BIG_MAX = 10000000;
+
     static constexpr int WIN_W = 1024;
     static constexpr int WIN_H = 768;
 
@@ -52,7 +86,14 @@ private:
     void regen_flow();
     void select_algo(int index, bool stop_play);
     void select_gen(int index);
-    void restart_active(bool stop_play, bool recreate_instance);
+    void select_point_count(int index);
+    void restart_active(bool stop_play);
+    void retire_worker();
+    void start_race();
+    bool advance();
+    bool stream_drained() const;
+    bool next_frame();
+    void update_progress();
 };
 
 #endif
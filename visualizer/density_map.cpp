@@ -0,0 +1,138 @@
+#include "visualizer/density_map.h"
+#include "core/parallel.h"
+#include <algorithm>
+#include <cmath>
+
+int DensityMap::pixel_x(float x) const {
+    int px = static_cast<int>(x);
+    return std::clamp(px, 0, width_ - 1);
+}
+
+int DensityMap::pixel_y(float y) const {
+    int py = static_cast<int>(y);
+    return std::clamp(py, 0, height_ - 1);
+}
+
+void DensityMap::build(const std::vector<core::Point>& pts, int width, int height) {
+    width_ = std::max(1, width);
+    height_ = std::max(1, height);
+    cols_ = (width_ + kCell - 1) / kCell;
+    rows_ = (height_ + kCell - 1) / kCell;
+
+    const std::size_t n = pts.size();
+    const std::size_t pixels = static_cast<std::size_t>(width_) * height_;
+    const std::size_t cells = static_cast<std::size_t>(cols_) * rows_;
+    const std::size_t chunks = core::chunk_count(n);
+
+    // pass 1, private cell histograms per thread, a 64th of the pixels each
+    std::vector<std::vector<std::uint32_t>> local_cell(chunks, std::vector<std::uint32_t>(cells, 0));
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        std::uint32_t* cl = local_cell[w].data();
+        for (std::size_t i = begin; i < end; ++i) {
+            const int x = pixel_x(pts[i].x);
+            const int y = pixel_y(pts[i].y);
+            ++cl[static_cast<std::size_t>(y / kCell) * cols_ + x / kCell];
+        }
+    });
+
+    // cell offsets, each thread gets its own cursor inside every cell
+    cell_start_.assign(cells + 1, 0);
+    std::uint32_t run = 0;
+    for (std::size_t c = 0; c < cells; ++c) {
+        cell_start_[c] = run;
+        for (auto& h : local_cell) {
+            const std::uint32_t cnt = h[c];
+            h[c] = run;
+            run += cnt;
+        }
+    }
+    cell_start_[cells] = run;
+
+    // pass 2, scatter indices with the same split as pass 1, each next to
+    // its pixel so pass 3 reads them in order instead of going back to pts
+    cell_points_.resize(n);
+    std::vector<std::uint32_t> cell_pixels(n);
+    core::parallel_chunks(n, [&](std::size_t begin, std::size_t end, unsigned w) {
+        std::uint32_t* cursor = local_cell[w].data();
+        for (std::size_t i = begin; i < end; ++i) {
+            const int x = pixel_x(pts[i].x);
+            const int y = pixel_y(pts[i].y);
+            const std::uint32_t slot = cursor[static_cast<std::size_t>(y / kCell) * cols_ + x / kCell]++;
+            cell_points_[slot] = static_cast<int>(i);
+            cell_pixels[slot] = static_cast<std::uint32_t>(y * width_ + x);
+        }
+    });
+    local_cell.clear();
+
+    // pass 3, pixel counts from the cells. a band of cell rows covers its
+    // own pixel rows, so threads count into the shared map without clashing
+    counts_.assign(pixels, 0);
+    std::vector<std::uint32_t> local_max(core::chunk_count(rows_, 1), 0);
+    core::parallel_chunks(static_cast<std::size_t>(rows_), [&](std::size_t begin, std::size_t end, unsigned w) {
+        std::uint32_t m = 0;
+        const std::uint32_t last = cell_start_[end * cols_];
+        for (std::uint32_t k = cell_start_[begin * cols_]; k < last; ++k) m = std::max(m, ++counts_[cell_pixels[k]]);
+        local_max[w] = m;
+    }, 1);
+    max_count_ = *std::max_element(local_max.begin(), local_max.end());
+}
+
+void DensityMap::to_rgba(std::vector<std::uint8_t>& rgba, std::uint8_t r, std::uint8_t g, std::uint8_t b) const {
+    const std::size_t pixels = counts_.size();
+    rgba.resize(pixels * 4);
+    const float inv = max_count_ > 0 ? 1.0f / std::log1p(static_cast<float>(max_count_)) : 0.0f;
+    core::parallel_chunks(pixels, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t p = begin; p < end; ++p) {
+            const std::uint32_t c = counts_[p];
+            const float t = c ? 0.35f + 0.65f * std::log1p(static_cast<float>(c)) * inv : 0.0f;
+            rgba[4 * p]     = static_cast<std::uint8_t>(r * t);
+            rgba[4 * p + 1] = static_cast<std::uint8_t>(g * t);
+            rgba[4 * p + 2] = static_cast<std::uint8_t>(b * t);
+            rgba[4 * p + 3] = c ? 255 : 0;
+        }
+    });
+}
+
+void DensityMap::points_near_segment(const std::vector<core::Point>& pts,
+                                     const core::Point& a, const core::Point& b,
+                                     float radius, std::size_t cap,
+                                     std::vector<int>& out) const {
+    out.clear();
+    if (cols_ == 0 || cap == 0) return;
+
+    // cells touched by the band around ab, sampled at half a cell along it
+    std::vector<int> cells;
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    const int samples = static_cast<int>(len / (kCell * 0.5f)) + 1;
+    const int reach = static_cast<int>(std::ceil(radius / kCell));
+    for (int s = 0; s <= samples; ++s) {
+        const float t = static_cast<float>(s) / static_cast<float>(samples);
+        const int cx = pixel_x(a.x + t * dx) / kCell;
+        const int cy = pixel_y(a.y + t * dy) / kCell;
+        for (int y = std::max(0, cy - reach); y <= std::min(rows_ - 1, cy + reach); ++y) {
+            for (int x = std::max(0, cx - reach); x <= std::min(cols_ - 1, cx + reach); ++x) {
+                cells.push_back(y * cols_ + x);
+            }
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    const float len2 = dx * dx + dy * dy;
+    const float r2 = radius * radius;
+    for (int c : cells) {
+        for (std::uint32_t k = cell_start_[c]; k < cell_start_[c + 1]; ++k) {
+            const core::Point& p = pts[cell_points_[k]];
+            float t = len2 > 0.0f ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2 : 0.0f;
+            t = std::clamp(t, 0.0f, 1.0f);
+            const float ex = a.x + t * dx - p.x;
+            const float ey = a.y + t * dy - p.y;
+            if (ex * ex + ey * ey <= r2) {
+                out.push_back(cell_points_[k]);
+                if (out.size() >= cap) return;
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef VIZ_DENSITY_MAP_H
+#define VIZ_DENSITY_MAP_H
+
+#include <cstdint>
+#include <vector>
+#include "core/types.h"
+
+// level of detail view of a large point set. points are binned into one
+// counter per pixel for the heatmap and into a coarse grid of cells that
+// keeps point indices, so the points near a segment can be found without
+// touching the rest. the grid is built in parallel from per thread cell
+// histograms, the pixel counts then from the grid, one band of rows per
+// thread
+class DensityMap {
+public:
+    void build(const std::vector<core::Point>& pts, int width, int height);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    std::uint32_t max_count() const { return max_count_; }
+    const std::vector<std::uint32_t>& counts() const { return counts_; }
+
+    // rgba heatmap, log scaled, empty pixels fully transparent
+    void to_rgba(std::vector<std::uint8_t>& rgba, std::uint8_t r, std::uint8_t g, std::uint8_t b) const;
+
+    // indices of points within radius of segment ab, at most cap of them
+    void points_near_segment(const std::vector<core::Point>& pts,
+                             const core::Point& a, const core::Point& b,
+                             float radius, std::size_t cap,
+                             std::vector<int>& out) const;
+
+    static constexpr int kCell = 8; // grid cell size in pixels
+
+private:
+    int width_{0};
+    int height_{0};
+    int cols_{0};
+    int rows_{0};
+    std::uint32_t max_count_{0};
+    std::vector<std::uint32_t> counts_;     // per pixel
+    std::vector<std::uint32_t> cell_start_; // csr offsets, cols_ * rows_ + 1
+    std::vector<int> cell_points_;          // point indices grouped by cell
+
+    int pixel_x(float x) const;
+    int pixel_y(float y) const;
+};
+
+#endif
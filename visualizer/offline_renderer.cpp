@@ -0,0 +1,170 @@
+#include "visualizer/offline_renderer.h"
+#include "visualizer/renderer.h"
+#include "visualizer/scene_painter.h"
+#include "core/parallel.h"
+#include "core/stopwatch.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    struct EncodeJob {
+        sf::Image image;
+        std::string path;
+    };
+
+    // bounded hand off from the render thread to the encoders
+    class EncodeQueue {
+    public:
+        explicit EncodeQueue(std::size_t limit) : limit_(std::max<std::size_t>(1, limit)) {}
+
+        void push(EncodeJob job) {
+            std::unique_lock<std::mutex> lock(mu_);
+            not_full_.wait(lock, [&] { return jobs_.size() < limit_; });
+            jobs_.push_back(std::move(job));
+            not_empty_.notify_one();
+        }
+
+        // false once closed and empty
+        bool pop(EncodeJob& out) {
+            std::unique_lock<std::mutex> lock(mu_);
+            not_empty_.wait(lock, [&] { return closed_ || !jobs_.empty(); });
+            if (jobs_.empty()) return false;
+            out = std::move(jobs_.front());
+            jobs_.pop_front();
+            not_full_.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mu_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+    private:
+        std::size_t limit_;
+        std::mutex mu_;
+        std::condition_variable not_full_;
+        std::condition_variable not_empty_;
+        std::deque<EncodeJob> jobs_;
+        bool closed_{false};
+    };
+}
+
+OfflineRenderer::OfflineRenderer(OfflineRenderConfig cfg) : cfg_(std::move(cfg)) {
+    if (cfg_.width == 0 || cfg_.height == 0) throw std::runtime_error("offline render size must not be zero");
+    cfg_.stride = std::max<std::size_t>(1, cfg_.stride);
+}
+
+OfflineRenderStats OfflineRenderer::render(ConvexHullAlgorithm& algo, const std::vector<core::Point>& pts) {
+    OfflineRenderStats stats;
+    Stopwatch total;
+    total.start();
+
+    const std::filesystem::path dir(cfg_.out_dir);
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) throw std::runtime_error("cannot create " + cfg_.out_dir + ": " + ec.message());
+
+    const sf::Vector2u size{cfg_.width, cfg_.height};
+    sf::RenderTexture target;
+    if (!target.resize(size)) throw std::runtime_error("cannot create an offscreen render texture");
+
+    ScenePainter painter;
+    painter.set_points(pts, size, pts.size() > Renderer::kLodThreshold);
+
+    sf::Font font;
+    std::optional<sf::Text> label;
+    if (cfg_.labels && font.openFromFile("../assets/DejaVuSans.ttf")) {
+        label.emplace(font, "", 14);
+        label->setFillColor(sf::Color::White);
+        label->setPosition({8.0f, static_cast<float>(cfg_.height) - 26.0f});
+    }
+
+    algo.reset(pts);
+    algo.begin_stepping();
+    const std::size_t count = algo.frame_count();
+
+    // the last frame is written on top of the strided ones, so the stride
+    // spreads the rest of a frame budget over the frames before it
+    stats.stride = cfg_.stride;
+    const std::size_t budget = cfg_.max_frames > 0 ? cfg_.max_frames : count;
+    if (cfg_.max_frames > 1 && count > 1) {
+        stats.stride = std::max(stats.stride, (count - 1 + cfg_.max_frames - 2) / (cfg_.max_frames - 1));
+    }
+
+    int encoders = cfg_.encoders > 0 ? cfg_.encoders : static_cast<int>(std::max(1u, core::worker_count() - 1));
+    EncodeQueue queue(cfg_.queue_limit);
+    std::atomic<long long> encode_ns{0};
+    std::atomic<bool> encode_failed{false};
+    std::vector<std::thread> pool;
+    pool.reserve(encoders);
+    for (int i = 0; i < encoders; ++i) {
+        pool.emplace_back([&] {
+            EncodeJob job;
+            while (queue.pop(job)) {
+                Stopwatch sw;
+                sw.start();
+                if (!job.image.saveToFile(job.path)) encode_failed.store(true, std::memory_order_relaxed);
+                sw.stop();
+                encode_ns.fetch_add(sw.ns(), std::memory_order_relaxed);
+            }
+        });
+    }
+
+    auto emit = [&](const core::HullFrame& fr) {
+        Stopwatch sw;
+        sw.start();
+        target.clear();
+        painter.draw(target, pts, fr);
+        if (label) {
+            label->setString(fr.label);
+            target.draw(*label);
+        }
+        target.display();
+        EncodeJob job{target.getTexture().copyToImage(), {}};
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06zu.png", stats.frames_written);
+        job.path = (dir / name).string();
+        sw.stop();
+        stats.render_ns += sw.ns();
+
+        sw.reset();
+        sw.start();
+        queue.push(std::move(job));
+        sw.stop();
+        stats.wait_ns += sw.ns();
+        ++stats.frames_written;
+    };
+
+    try {
+        for (std::size_t index = 0; index < count; ++index) {
+            if (index > 0) algo.step();
+            ++stats.frames_seen;
+            // the finished hull always ends the sequence
+            const bool last = index + 1 == count;
+            if (last || (index % stats.stride == 0 && stats.frames_written + 1 < budget)) emit(algo.frame());
+        }
+    } catch (...) {
+        queue.close();
+        for (std::thread& t : pool) t.join();
+        throw;
+    }
+
+    queue.close();
+    for (std::thread& t : pool) t.join();
+    if (encode_failed.load()) throw std::runtime_error("cannot write png frames to " + cfg_.out_dir);
+
+    stats.encode_ns = encode_ns.load();
+    total.stop();
+    stats.total_ns = total.ns();
+    return stats;
+}
@@ -0,0 +1,43 @@
+#ifndef VIZ_OFFLINE_RENDERER_H
+#define VIZ_OFFLINE_RENDERER_H
+
+#include <string>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+
+struct OfflineRenderConfig {
+    std::string out_dir{"frames"};
+    unsigned width{1024};
+    unsigned height{768};
+    std::size_t stride{1};     // render every stride-th frame, the last one always
+    std::size_t max_frames{0}; // when set the stride grows so at most this many are written
+    int encoders{0};           // png encoder threads, 0 picks one per spare core
+    std::size_t queue_limit{32}; // rendered images waiting for an encoder
+    bool labels{true};         // draw the frame label when the font is found
+};
+
+struct OfflineRenderStats {
+    std::size_t frames_seen{0};
+    std::size_t frames_written{0};
+    std::size_t stride{1};
+    long long render_ns{0}; // drawing and reading back, on the calling thread
+    long long wait_ns{0};   // calling thread blocked on a full encoder queue
+    long long encode_ns{0}; // summed over all encoder threads
+    long long total_ns{0};
+};
+
+// renders the stepping frames of an algorithm into an offscreen texture and
+// writes them as frame_000000.png and up into out_dir. no window is opened.
+// images are encoded on a pool of threads while the next ones are drawn
+class OfflineRenderer {
+public:
+    explicit OfflineRenderer(OfflineRenderConfig cfg);
+
+    OfflineRenderStats render(ConvexHullAlgorithm& algo, const std::vector<core::Point>& pts);
+
+private:
+    OfflineRenderConfig cfg_;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "visualizer/race.h"
+#include "core/stopwatch.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+// at small n a single run is far below timer noise, so runs are repeated
+// until this much time has been spent (or kMaxRuns is hit)
+static constexpr double kMinSampleMs = 50.0;
+static constexpr int kMaxRuns = 1000;
+
+static double median_ms(std::vector<long long>& ns) {
+    if (ns.empty()) return 0.0;
+    std::nth_element(ns.begin(), ns.begin() + ns.size() / 2, ns.end());
+    return static_cast<double>(ns[ns.size() / 2]) / 1e6;
+}
+
+Race::Race(std::vector<Entry> algos, const std::vector<core::Point>& pts, bool stepping,
+           PointSource big_source, std::size_t big_n)
+    : points_(pts),
+      big_n_(big_source ? big_n : 0) {
+    lanes_.reserve(algos.size());
+    for (Entry& e : algos) {
+        auto lane = std::make_unique<Lane>();
+        lane->name = std::move(e.name);
+        lane->make = std::move(e.make);
+        lane->frame.label = "computing";
+        lane->frames = std::make_unique<StepWorker>(lane->make(), points_, stepping);
+        lanes_.push_back(std::move(lane));
+    }
+    for (auto& lane : lanes_) {
+        Lane* l = lane.get();
+        l->timer = std::thread([this, l] { time_lane(*l); });
+    }
+    if (big_n_ > 0) {
+        big_thread_ = std::thread([this, source = std::move(big_source)] { time_big(source); });
+    } else {
+        big_done_.store(true, std::memory_order_release);
+    }
+}
+
+Race::~Race() {
+    cancel();
+    for (auto& lane : lanes_) {
+        if (lane->timer.joinable()) lane->timer.join();
+    }
+    if (big_thread_.joinable()) big_thread_.join();
+}
+
+void Race::cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+    stop_.request_stop();
+    for (auto& lane : lanes_) lane->frames->cancel();
+}
+
+bool Race::finished() const {
+    if (!big_done_.load(std::memory_order_acquire)) return false;
+    for (const auto& lane : lanes_) {
+        if (!lane->timer_done.load(std::memory_order_acquire) || !lane->frames->finished()) return false;
+    }
+    return true;
+}
+
+void Race::time_lane(Lane& lane) {
+    try {
+        auto algo = lane.make();
+        algo->reset(points_);
+        std::vector<long long> samples;
+        double spent_ms = 0.0;
+        int hull = 0;
+        while (!cancel_.load(std::memory_order_relaxed) &&
+               (static_cast<int>(samples.size()) < kRepeats ||
+                (spent_ms < kMinSampleMs && static_cast<int>(samples.size()) < kMaxRuns))) {
+            Stopwatch sw;
+            sw.start();
+            hull = static_cast<int>(algo->run_full().size());
+            sw.stop();
+            samples.push_back(sw.ns());
+            spent_ms += static_cast<double>(sw.ns()) / 1e6;
+        }
+        lane.hull_size.store(hull, std::memory_order_relaxed);
+        lane.run_ms.store(median_ms(samples), std::memory_order_relaxed);
+    } catch (const std::exception&) {
+        // leaves run_ms at zero, shown as a failed lane
+    }
+    lane.timer_done.store(true, std::memory_order_release);
+}
+
+void Race::time_big(PointSource source) {
+    try {
+        // wait for the concurrent lanes so the big runs have the machine
+        for (auto& lane : lanes_) {
+            while (!lane->timer_done.load(std::memory_order_acquire)) {
+                if (cancel_.load(std::memory_order_relaxed)) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        std::vector<core::Point> big;
+        if (!cancel_.load(std::memory_order_relaxed)) big = source(big_n_);
+        for (auto& lane : lanes_) {
+            if (cancel_.load(std::memory_order_relaxed)) break;
+            auto algo = lane->make();
+            algo->reset(big);
+            std::vector<long long> samples;
+            for (int r = 0; r < kRepeats && !cancel_.load(std::memory_order_relaxed); ++r) {
+                Stopwatch sw;
+                sw.start();
+                algo->run_cancellable(stop_.get_token());
+                sw.stop();
+                samples.push_back(sw.ns());
+            }
+            if (static_cast<int>(samples.size()) == kRepeats) {
+                lane->big_ms.store(median_ms(samples), std::memory_order_relaxed);
+            }
+        }
+    } catch (const std::exception&) {
+        // big timings stay pending
+    }
+    big_done_.store(true, std::memory_order_release);
+}
+
+void Race::poll_frames() {
+    for (auto& lane : lanes_) {
+        if (lane->have_frame) continue;
+        if (lane->frames->pop(lane->frame)) lane->have_frame = true;
+    }
+}
+
+bool Race::advance() {
+    bool any = false;
+    for (auto& lane : lanes_) {
+        core::HullFrame fr;
+        if (lane->frames->pop(fr)) {
+            lane->frame = std::move(fr);
+            lane->have_frame = true;
+            any = true;
+        }
+    }
+    return any;
+}
+
+bool Race::drained() const {
+    for (const auto& lane : lanes_) {
+        if (!lane->frames->drained()) return false;
+    }
+    return true;
+}
+
+std::vector<RacePanel> Race::panels() const {
+    std::vector<RacePanel> out;
+    out.reserve(lanes_.size());
+    for (const auto& lane : lanes_) {
+        RacePanel p;
+        p.name = lane->name;
+        p.frame = &lane->frame;
+        p.run_ms = lane->run_ms.load(std::memory_order_relaxed);
+        p.hull_size = lane->hull_size.load(std::memory_order_relaxed);
+        p.big_ms = lane->big_ms.load(std::memory_order_relaxed);
+        out.push_back(std::move(p));
+    }
+    return out;
+}
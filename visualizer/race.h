@@ -0,0 +1,78 @@
+#ifndef VIZ_RACE_H
+#define VIZ_RACE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/types.h"
+#include "visualizer/renderer.h"
+#include "visualizer/step_worker.h"
+
+// every algorithm on the same input at once. each lane streams its frames
+// through a StepWorker and times run_full on its own thread. a background
+// thread then repeats the runs at a larger n one algorithm after the other,
+// so those medians are not disturbed by the other lanes
+class Race {
+public:
+    using AlgoFactory = std::function<std::unique_ptr<ConvexHullAlgorithm>()>;
+    using PointSource = std::function<std::vector<core::Point>(std::size_t)>;
+
+    struct Entry {
+        std::string name;
+        AlgoFactory make;
+    };
+
+    // big_n of 0 skips the background runs
+    Race(std::vector<Entry> algos, const std::vector<core::Point>& pts, bool stepping,
+         PointSource big_source, std::size_t big_n);
+    ~Race(); // cancels and joins
+    Race(const Race&) = delete;
+    Race& operator=(const Race&) = delete;
+
+    void cancel();
+    // every thread has returned, joining will not block
+    bool finished() const;
+
+    // take the first frame of lanes that have none yet
+    void poll_frames();
+    // next frame in every lane, false when all lanes are drained
+    bool advance();
+    bool drained() const;
+
+    std::vector<RacePanel> panels() const;
+    std::size_t big_n() const { return big_n_; }
+
+    static constexpr int kRepeats = 5;
+
+private:
+    struct Lane {
+        std::string name;
+        AlgoFactory make;
+        std::unique_ptr<StepWorker> frames;
+        core::HullFrame frame;
+        bool have_frame{false};
+        std::atomic<double> run_ms{0.0};
+        std::atomic<int> hull_size{0};
+        std::atomic<double> big_ms{0.0};
+        std::atomic<bool> timer_done{false};
+        std::thread timer;
+    };
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::vector<core::Point> points_;
+    std::size_t big_n_{0};
+    std::atomic<bool> cancel_{false};
+    std::stop_source stop_; // reaches into a big run already going
+    std::atomic<bool> big_done_{false};
+    std::thread big_thread_;
+
+    void time_lane(Lane& lane);
+    void time_big(PointSource source);
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include "visualizer/renderer.h"
+#include "visualizer/scene_painter.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <optional>
 #include <filesystem>
@@ -18,12 +21,173 @@ struct Renderer::Impl {
     bool faster_now{false};
     bool slower_now{false};
     bool toggle_slomo_now{false};
+    bool more_points_now{false};
+    bool fewer_points_now{false};
+    bool toggle_race_now{false};
+
+    ScenePainter painter;
 
     bool overlay_loaded{false};
     bool overlay_ok{false};
     sf::Font overlay_font;
+
+    // hud cache. everything but the status line is drawn into hud_rt and
+    // only redrawn when one of its inputs changes
+    struct HudKey {
+        std::vector<std::string> algo_labels;
+        int active_algo{-1};
+        std::vector<std::string> gen_labels;
+        int active_gen{-1};
+        float speed{0.0f};
+        bool slomo{false};
+        int run_ms{0};
+        std::size_t points{0};
+        unsigned width{0};
+        unsigned height{0};
+    };
+    HudKey hud_key;
+    bool hud_valid{false};
+    sf::RenderTexture hud_rt;
+    std::optional<sf::Sprite> hud_sprite;
+    float hud_top{0.0f};
+    float status_y{0.0f};
+    std::optional<sf::Text> status_text;
+    std::string status_cached;
+
+    // race view, the hull lines of one panel at a time and text that is only
+    // reshaped when its string changes
+    sf::VertexArray race_va{sf::PrimitiveType::Lines};
+    std::vector<sf::Text> race_titles;
+    std::vector<std::string> race_titles_cached;
+    std::optional<sf::Text> race_table;
+    std::string race_table_cached;
+
+    void rebuild_hud();
+    void draw_hud(const std::string& status);
 };
 
+static constexpr unsigned kHudSize = 14;
+static constexpr float kHudMargin = 8.0f;
+
+void Renderer::Impl::rebuild_hud() {
+    const HudKey& k = hud_key;
+
+    sf::Text algoPrefix(overlay_font, "Algorithms: ", kHudSize);
+    algoPrefix.setFillColor(sf::Color::White);
+
+    std::vector<sf::Text> algoItems;
+    algoItems.reserve(k.algo_labels.size());
+    for (std::size_t i = 0; i < k.algo_labels.size(); ++i) {
+        std::string label = std::to_string(static_cast<int>(i + 1)) + " " + k.algo_labels[i];
+        if (static_cast<int>(i) == k.active_algo) label = "[" + label + "]";
+        sf::Text t(overlay_font, label + "    ", kHudSize);
+        t.setFillColor(sf::Color::White);
+        if (static_cast<int>(i) == k.active_algo) t.setStyle(sf::Text::Style::Bold);
+        algoItems.push_back(t);
+    }
+
+    sf::Text genPrefix(overlay_font, "Generation: ", kHudSize);
+    genPrefix.setFillColor(sf::Color::White);
+
+    std::vector<sf::Text> genItems;
+    genItems.reserve(k.gen_labels.size());
+    for (std::size_t i = 0; i < k.gen_labels.size(); ++i) {
+        std::string label = "F" + std::to_string(static_cast<int>(i + 1)) + " " + k.gen_labels[i];
+        if (static_cast<int>(i) == k.active_gen) label = "[" + label + "]";
+        sf::Text t(overlay_font, label + "    ", kHudSize);
+        t.setFillColor(sf::Color::White);
+        if (static_cast<int>(i) == k.active_gen) t.setStyle(sf::Text::Style::Bold);
+        genItems.push_back(t);
+    }
+
+    sf::Text controlsText(overlay_font, "Controls: Enter next, Space play, Esc reset, R random, numbers choose algo, F1 to F9 choose generator, Up faster, Down slower, S slomo, PgUp PgDn points, C race", kHudSize);
+    controlsText.setFillColor(sf::Color::White);
+
+    std::ostringstream spd;
+    spd << "Speed " << std::fixed << std::setprecision(2) << k.speed << "x";
+    if (k.slomo) spd << "  slomo on";
+    spd << "    points " << k.points;
+    if (k.run_ms > 0) spd << "    last run ms " << k.run_ms;
+    sf::Text speedText(overlay_font, spd.str(), kHudSize);
+    speedText.setFillColor(sf::Color::White);
+
+    float h1 = std::max(algoPrefix.getLocalBounds().size.y, static_cast<float>(kHudSize));
+    for (auto& t : algoItems) h1 = std::max(h1, t.getLocalBounds().size.y);
+
+    float hG = std::max(genPrefix.getLocalBounds().size.y, static_cast<float>(kHudSize));
+    for (auto& t : genItems) hG = std::max(hG, t.getLocalBounds().size.y);
+
+    float h2 = controlsText.getLocalBounds().size.y;
+    float h3 = speedText.getLocalBounds().size.y;
+    // the status line changes nearly every frame, reserve a fixed row for it
+    float h4 = static_cast<float>(kHudSize) + 4.0f;
+
+    float total_h = h1 + hG + h2 + h3 + h4 + 24.0f;
+    hud_top = static_cast<float>(k.height) - total_h - kHudMargin - 6.0f;
+
+    const sf::Vector2u size{k.width, static_cast<unsigned>(total_h + 12.0f)};
+    if (hud_rt.getSize().x != size.x || hud_rt.getSize().y != size.y) {
+        hud_sprite.reset();
+        if (!hud_rt.resize(size)) {
+            overlay_ok = false;
+            return;
+        }
+    }
+    hud_rt.clear(sf::Color(0, 0, 0, 140));
+
+    float y = 6.0f;
+    float x = kHudMargin;
+    algoPrefix.setPosition({x, y});
+    hud_rt.draw(algoPrefix);
+    x += algoPrefix.getLocalBounds().size.x;
+    for (auto& t : algoItems) {
+        t.setPosition({x, y});
+        hud_rt.draw(t);
+        x += t.getLocalBounds().size.x;
+    }
+
+    float yG = y + h1 + 2.0f;
+    x = kHudMargin;
+    genPrefix.setPosition({x, yG});
+    hud_rt.draw(genPrefix);
+    x += genPrefix.getLocalBounds().size.x;
+    for (auto& t : genItems) {
+        t.setPosition({x, yG});
+        hud_rt.draw(t);
+        x += t.getLocalBounds().size.x;
+    }
+
+    float y2 = yG + hG + 2.0f;
+    controlsText.setPosition({kHudMargin, y2});
+    hud_rt.draw(controlsText);
+
+    float y3 = y2 + h2 + 2.0f;
+    speedText.setPosition({kHudMargin, y3});
+    hud_rt.draw(speedText);
+
+    hud_rt.display();
+    if (!hud_sprite) hud_sprite.emplace(hud_rt.getTexture());
+    hud_sprite->setPosition({0.0f, hud_top});
+
+    status_y = hud_top + y3 + h3 + 2.0f;
+    if (!status_text) {
+        status_text.emplace(overlay_font, status_cached, kHudSize);
+        status_text->setFillColor(sf::Color::White);
+    }
+    status_text->setPosition({kHudMargin, status_y});
+    hud_valid = true;
+}
+
+void Renderer::Impl::draw_hud(const std::string& status) {
+    if (!hud_sprite || !status_text) return;
+    win->draw(*hud_sprite);
+    if (status != status_cached) {
+        status_cached = status;
+        status_text->setString(status_cached);
+    }
+    win->draw(*status_text);
+}
+
 Renderer::Renderer() : impl(new Impl) {}
 Renderer::~Renderer() {}
 
@@ -46,6 +210,9 @@ void Renderer::poll() {
     impl->faster_now = false;
     impl->slower_now = false;
     impl->toggle_slomo_now = false;
+    impl->more_points_now = false;
+    impl->fewer_points_now = false;
+    impl->toggle_race_now = false;
 
     while (const std::optional<sf::Event> ev = impl->win->pollEvent()) {
         if (ev->is<sf::Event::Closed>()) {
@@ -81,6 +248,9 @@ void Renderer::poll() {
                 case sf::Keyboard::Key::Up:    impl->faster_now = true; break;
                 case sf::Keyboard::Key::Down:  impl->slower_now = true; break;
                 case sf::Keyboard::Key::S:     impl->toggle_slomo_now = true; break;
+                case sf::Keyboard::Key::PageUp:   impl->more_points_now = true; break;
+                case sf::Keyboard::Key::PageDown: impl->fewer_points_now = true; break;
+                case sf::Keyboard::Key::C:     impl->toggle_race_now = true; break;
                 case sf::Keyboard::Key::Escape: impl->reset_now = true; break;
                 default: break;
             }
@@ -97,13 +267,15 @@ bool Renderer::is_playing() const { return impl->play; }
 bool Renderer::wants_faster() const { return impl->faster_now; }
 bool Renderer::wants_slower() const { return impl->slower_now; }
 bool Renderer::wants_toggle_slomo() const { return impl->toggle_slomo_now; }
+bool Renderer::wants_more_points() const { return impl->more_points_now; }
+bool Renderer::wants_fewer_points() const { return impl->fewer_points_now; }
+bool Renderer::wants_toggle_race() const { return impl->toggle_race_now; }
 void Renderer::set_play(bool on) { impl->play = on; }
 
-static sf::Color color_point() { return sf::Color(180, 180, 180); }
-static sf::Color color_hull()  { return sf::Color(0, 200, 255); }
-static sf::Color color_a()     { return sf::Color(255, 80, 80); }
-static sf::Color color_b()     { return sf::Color(80, 255, 120); }
-static sf::Color color_c()     { return sf::Color(255, 220, 80); }
+void Renderer::set_points(const std::vector<core::Point>& pts) {
+    if (!impl->win) return;
+    impl->painter.set_points(pts, impl->win->getSize(), pts.size() > kLodThreshold);
+}
 
 void Renderer::draw_scene(const std::vector<core::Point>& pts,
                           const std::vector<std::string>& algo_labels,
@@ -117,36 +289,81 @@ void Renderer::draw_scene(const std::vector<core::Point>& pts,
     if (!impl->win || !impl->win->isOpen()) return;
 
     impl->win->clear();
+    impl->painter.draw(*impl->win, pts, fr);
 
-    for (auto& p : pts) {
-        sf::CircleShape dot(3.0f);
-        dot.setPosition({p.x - 3.0f, p.y - 3.0f});
-        dot.setFillColor(color_point());
-        impl->win->draw(dot);
+    if (!impl->overlay_loaded) {
+        if (!impl->overlay_ok) impl->overlay_ok = impl->overlay_font.openFromFile("../assets/DejaVuSans.ttf");
+        impl->overlay_loaded = true;
     }
 
-    if (fr.hull_indices.size() >= 2) {
-        for (std::size_t i = 0; i < fr.hull_indices.size(); ++i) {
-            int a = fr.hull_indices[i];
-            int b = fr.hull_indices[(i + 1) % fr.hull_indices.size()];
-            sf::Vertex seg[] = {
-                sf::Vertex{sf::Vector2f(pts[a].x, pts[a].y), color_hull()},
-                sf::Vertex{sf::Vector2f(pts[b].x, pts[b].y), color_hull()}
-            };
-            impl->win->draw(seg, 2, sf::PrimitiveType::Lines);
+    if (impl->overlay_ok) {
+        Impl::HudKey& key = impl->hud_key;
+        const auto winSize = impl->win->getSize();
+        const int run_ms = static_cast<int>(last_run_ms);
+        // compared field by field, so an unchanged hud costs no allocation
+        if (!impl->hud_valid ||
+            key.active_algo != active_algo_index || key.active_gen != active_gen_index ||
+            key.speed != speed_multiplier || key.slomo != slomo_on || key.run_ms != run_ms ||
+            key.points != pts.size() || key.width != winSize.x || key.height != winSize.y ||
+            key.algo_labels != algo_labels || key.gen_labels != gen_labels) {
+            key.algo_labels = algo_labels;
+            key.active_algo = active_algo_index;
+            key.gen_labels = gen_labels;
+            key.active_gen = active_gen_index;
+            key.speed = speed_multiplier;
+            key.slomo = slomo_on;
+            key.run_ms = run_ms;
+            key.points = pts.size();
+            key.width = winSize.x;
+            key.height = winSize.y;
+            impl->rebuild_hud();
         }
+        if (impl->overlay_ok) impl->draw_hud(fr.label);
     }
 
-    auto draw_mark = [&](int idx, sf::Color c) {
-        if (idx < 0 || idx >= static_cast<int>(pts.size())) return;
-        sf::CircleShape mark(6.0f);
-        mark.setPosition({pts[idx].x - 6.0f, pts[idx].y - 6.0f});
-        mark.setFillColor(c);
-        impl->win->draw(mark);
-    };
-    draw_mark(fr.active_a, color_a());
-    draw_mark(fr.active_b, color_b());
-    draw_mark(fr.active_c, color_c());
+    impl->win->display();
+}
+
+void Renderer::draw_race(const std::vector<core::Point>& pts,
+                         const std::vector<RacePanel>& panels,
+                         std::size_t big_n) {
+    if (!impl->win || !impl->win->isOpen()) return;
+
+    impl->win->clear();
+    const sf::View screen = impl->win->getDefaultView();
+    const sf::Vector2f size = screen.getSize();
+    const int k = static_cast<int>(panels.size());
+    const int cols = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(k)))));
+    const int rows = std::max(1, (k + cols - 1) / cols);
+    const float cw = 1.0f / static_cast<float>(cols);
+    const float ch = 1.0f / static_cast<float>(rows);
+
+    // every panel looks at the whole point set through its own viewport
+    for (int i = 0; i < k; ++i) {
+        const core::HullFrame& fr = *panels[i].frame;
+        sf::View view = screen;
+        view.setViewport(sf::FloatRect({cw * static_cast<float>(i % cols), ch * static_cast<float>(i / cols)}, {cw, ch}));
+        impl->win->setView(view);
+        impl->painter.draw_points(*impl->win);
+        ScenePainter::hull_lines(impl->race_va, pts, fr);
+        impl->win->draw(impl->race_va);
+        impl->painter.draw_marks(*impl->win, pts, fr);
+    }
+    impl->win->setView(screen);
+
+    // panel borders
+    sf::VertexArray grid(sf::PrimitiveType::Lines);
+    for (int c = 1; c < cols; ++c) {
+        const float x = size.x * cw * static_cast<float>(c);
+        grid.append(sf::Vertex{sf::Vector2f(x, 0.0f), sf::Color(90, 90, 90)});
+        grid.append(sf::Vertex{sf::Vector2f(x, size.y), sf::Color(90, 90, 90)});
+    }
+    for (int r = 1; r < rows; ++r) {
+        const float y = size.y * ch * static_cast<float>(r);
+        grid.append(sf::Vertex{sf::Vector2f(0.0f, y), sf::Color(90, 90, 90)});
+        grid.append(sf::Vertex{sf::Vector2f(size.x, y), sf::Color(90, 90, 90)});
+    }
+    impl->win->draw(grid);
 
     if (!impl->overlay_loaded) {
         if (!impl->overlay_ok) impl->overlay_ok = impl->overlay_font.openFromFile("../assets/DejaVuSans.ttf");
@@ -154,105 +371,52 @@ void Renderer::draw_scene(const std::vector<core::Point>& pts,
     }
 
     if (impl->overlay_ok) {
-        const unsigned kSize = 14;
-        float margin = 8.0f;
-
-        sf::Text algoPrefix(impl->overlay_font, "Algorithms: ", kSize);
-        algoPrefix.setFillColor(sf::Color::White);
-
-        std::vector<sf::Text> algoItems;
-        algoItems.reserve(algo_labels.size());
-        for (std::size_t i = 0; i < algo_labels.size(); ++i) {
-            std::string label = std::to_string(static_cast<int>(i + 1)) + " " + algo_labels[i];
-            if (static_cast<int>(i) == active_algo_index) label = "[" + label + "]";
-            sf::Text t(impl->overlay_font, label + "    ", kSize);
-            t.setFillColor(sf::Color::White);
-            if (static_cast<int>(i) == active_algo_index) t.setStyle(sf::Text::Style::Bold);
-            algoItems.push_back(t);
+        if (impl->race_titles.size() != panels.size()) {
+            impl->race_titles.assign(panels.size(), sf::Text(impl->overlay_font, "", kHudSize));
+            impl->race_titles_cached.assign(panels.size(), std::string());
         }
-
-        sf::Text genPrefix(impl->overlay_font, "Generation: ", kSize);
-        genPrefix.setFillColor(sf::Color::White);
-
-        std::vector<sf::Text> genItems;
-        genItems.reserve(gen_labels.size());
-        for (std::size_t i = 0; i < gen_labels.size(); ++i) {
-            std::string label = "F" + std::to_string(static_cast<int>(i + 1)) + " " + gen_labels[i];
-            if (static_cast<int>(i) == active_gen_index) label = "[" + label + "]";
-            sf::Text t(impl->overlay_font, label + "    ", kSize);
-            t.setFillColor(sf::Color::White);
-            if (static_cast<int>(i) == active_gen_index) t.setStyle(sf::Text::Style::Bold);
-            genItems.push_back(t);
+        for (int i = 0; i < k; ++i) {
+            std::string title = panels[i].name + "  " + panels[i].frame->label;
+            if (title != impl->race_titles_cached[i]) {
+                impl->race_titles_cached[i] = title;
+                impl->race_titles[i].setString(title);
+            }
+            impl->race_titles[i].setPosition({size.x * cw * static_cast<float>(i % cols) + kHudMargin,
+                                              size.y * ch * static_cast<float>(i / cols) + kHudMargin});
+            impl->win->draw(impl->race_titles[i]);
         }
 
-        std::ostringstream ss;
-        ss << "Controls: Enter next, Space play, Esc reset, R random, numbers choose algo, F1 to F9 choose generator, Up faster, Down slower, S slomo";
-        sf::Text controlsText(impl->overlay_font, ss.str(), kSize);
-        controlsText.setFillColor(sf::Color::White);
-
-        std::ostringstream spd;
-        spd << "Speed " << std::fixed << std::setprecision(2) << speed_multiplier << "x";
-        if (slomo_on) spd << "  slomo on";
-        if (last_run_ms > 0.0) spd << "    last run ms " << static_cast<int>(last_run_ms);
-        sf::Text speedText(impl->overlay_font, spd.str(), kSize);
-        speedText.setFillColor(sf::Color::White);
-
-        sf::Text status(impl->overlay_font, fr.label, kSize);
-        status.setFillColor(sf::Color::White);
-
-        float h1 = std::max(algoPrefix.getLocalBounds().size.y, static_cast<float>(kSize));
-        for (auto& t : algoItems) h1 = std::max(h1, t.getLocalBounds().size.y);
-
-        float hG = std::max(genPrefix.getLocalBounds().size.y, static_cast<float>(kSize));
-        for (auto& t : genItems) hG = std::max(hG, t.getLocalBounds().size.y);
-
-        float h2 = controlsText.getLocalBounds().size.y;
-        float h3 = speedText.getLocalBounds().size.y;
-        float h4 = status.getLocalBounds().size.y;
-
-        float total_h = h1 + hG + h2 + h3 + h4 + 24.0f;
-
-        auto winSize = impl->win->getSize();
-        float y = static_cast<float>(winSize.y) - total_h - margin;
-
-        sf::RectangleShape bg;
-        bg.setPosition({0.f, y - 6.0f});
-        bg.setSize({static_cast<float>(winSize.x), total_h + 12.0f});
-        bg.setFillColor(sf::Color(0, 0, 0, 140));
-        impl->win->draw(bg);
-
-        float x = margin;
-        algoPrefix.setPosition({x, y});
-        impl->win->draw(algoPrefix);
-        x += algoPrefix.getLocalBounds().size.x;
-        for (auto& t : algoItems) {
-            t.setPosition({x, y});
-            impl->win->draw(t);
-            x += t.getLocalBounds().size.x;
+        // comparison table, timings are medians
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3);
+        os << "Race on " << pts.size() << " points, C to leave\n";
+        for (const RacePanel& p : panels) {
+            os << p.name << "    ";
+            if (p.run_ms > 0.0) os << "run ms " << p.run_ms << "    hull " << p.hull_size;
+            else os << "timing...";
+            if (big_n > 0) {
+                os << "    at " << big_n << " points ";
+                if (p.big_ms > 0.0) os << "run ms " << p.big_ms;
+                else os << "pending";
+            }
+            os << "\n";
         }
-
-        float yG = y + h1 + 2.0f;
-        x = margin;
-        genPrefix.setPosition({x, yG});
-        impl->win->draw(genPrefix);
-        x += genPrefix.getLocalBounds().size.x;
-        for (auto& t : genItems) {
-            t.setPosition({x, yG});
-            impl->win->draw(t);
-            x += t.getLocalBounds().size.x;
+        const std::string table = os.str();
+        if (!impl->race_table) {
+            impl->race_table.emplace(impl->overlay_font, "", kHudSize);
+            impl->race_table->setFillColor(sf::Color::White);
         }
-
-        float y2 = yG + hG + 2.0f;
-        controlsText.setPosition({margin, y2});
-        impl->win->draw(controlsText);
-
-        float y3 = y2 + h2 + 2.0f;
-        speedText.setPosition({margin, y3});
-        impl->win->draw(speedText);
-
-        float y4 = y3 + h3 + 2.0f;
-        status.setPosition({margin, y4});
-        impl->win->draw(status);
+        if (table != impl->race_table_cached) {
+            impl->race_table_cached = table;
+            impl->race_table->setString(table);
+        }
+        const sf::FloatRect bounds = impl->race_table->getLocalBounds();
+        sf::RectangleShape back({size.x, bounds.size.y + 2.0f * kHudMargin + 4.0f});
+        back.setPosition({0.0f, size.y - back.getSize().y});
+        back.setFillColor(sf::Color(0, 0, 0, 170));
+        impl->win->draw(back);
+        impl->race_table->setPosition({kHudMargin, size.y - back.getSize().y + kHudMargin});
+        impl->win->draw(*impl->race_table);
     }
 
     impl->win->display();
@@ -8,6 +8,16 @@
 
 namespace sf { class RenderWindow; }
 
+// one viewport of the race view. run_ms and big_ms stay at zero until the
+// timing for that lane is in
+struct RacePanel {
+    std::string name;
+    const core::HullFrame* frame{nullptr};
+    double run_ms{0.0};
+    int hull_size{0};
+    double big_ms{0.0};
+};
+
 class Renderer {
 public:
     Renderer();
@@ -17,6 +27,11 @@ public:
     bool is_open() const;
     void poll();
 
+    // upload the point set once, draw_scene reuses it until the next call.
+    // above kLodThreshold points a density heatmap replaces the per point dots
+    void set_points(const std::vector<core::Point>& pts);
+    static constexpr std::size_t kLodThreshold = 100000;
+
     void draw_scene(const std::vector<core::Point>& pts,
                     const std::vector<std::string>& algo_labels,
                     int active_algo_index,
@@ -27,6 +42,11 @@ public:
                     float speed_multiplier,
                     bool slomo_on);
 
+    // every algorithm in its own viewport plus a comparison table
+    void draw_race(const std::vector<core::Point>& pts,
+                   const std::vector<RacePanel>& panels,
+                   std::size_t big_n);
+
     bool is_playing() const;
     bool wants_step() const;
     bool wants_regen() const;
@@ -37,6 +57,9 @@ public:
     bool wants_faster() const;
     bool wants_slower() const;
     bool wants_toggle_slomo() const;
+    bool wants_more_points() const;
+    bool wants_fewer_points() const;
+    bool wants_toggle_race() const;
 
     void set_play(bool on);
 
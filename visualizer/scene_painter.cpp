@@ -0,0 +1,128 @@
+#include "visualizer/scene_painter.h"
+
+static sf::Color color_point() { return sf::Color(180, 180, 180); }
+static sf::Color color_hull()  { return sf::Color(0, 200, 255); }
+static sf::Color color_a()     { return sf::Color(255, 80, 80); }
+static sf::Color color_b()     { return sf::Color(80, 255, 120); }
+static sf::Color color_c()     { return sf::Color(255, 220, 80); }
+
+static constexpr float kDotHalf = 2.5f;
+
+// two triangles per point, written at slot i of a triangle vertex array
+static void put_dot(sf::VertexArray& va, std::size_t i, float x, float y, sf::Color c) {
+    const sf::Vector2f tl{x - kDotHalf, y - kDotHalf};
+    const sf::Vector2f tr{x + kDotHalf, y - kDotHalf};
+    const sf::Vector2f bl{x - kDotHalf, y + kDotHalf};
+    const sf::Vector2f br{x + kDotHalf, y + kDotHalf};
+    sf::Vertex* v = &va[6 * i];
+    v[0].position = tl; v[1].position = tr; v[2].position = br;
+    v[3].position = tl; v[4].position = br; v[5].position = bl;
+    for (int k = 0; k < 6; ++k) v[k].color = c;
+}
+
+void ScenePainter::set_points(const std::vector<core::Point>& pts, sf::Vector2u size, bool lod) {
+    hull_dirty_ = true;
+    detail_a_ = -2;
+    points_on_gpu_ = false;
+    points_va_ = sf::VertexArray(sf::PrimitiveType::Triangles);
+
+    lod_ = lod;
+    if (lod_) {
+        density_.build(pts, static_cast<int>(size.x), static_cast<int>(size.y));
+        std::vector<std::uint8_t> rgba;
+        const sf::Color c = color_point();
+        density_.to_rgba(rgba, c.r, c.g, c.b);
+        density_sprite_.reset();
+        if (density_tex_.resize(size)) {
+            density_tex_.update(rgba.data());
+            density_sprite_.emplace(density_tex_);
+        }
+        return;
+    }
+    density_sprite_.reset();
+
+    points_va_.resize(6 * pts.size());
+    for (std::size_t i = 0; i < pts.size(); ++i) put_dot(points_va_, i, pts[i].x, pts[i].y, color_point());
+
+    // keep the vertices on the gpu when we can and drop the cpu copy
+    const std::size_t count = points_va_.getVertexCount();
+    if (count > 0 && sf::VertexBuffer::isAvailable() &&
+        points_vb_.create(count) &&
+        points_vb_.update(&points_va_[0], count, 0)) {
+        points_on_gpu_ = true;
+        points_va_ = sf::VertexArray(sf::PrimitiveType::Triangles);
+    }
+}
+
+void ScenePainter::draw(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr) {
+    draw_points(target);
+    draw_hull(target, pts, fr);
+    draw_marks(target, pts, fr);
+}
+
+void ScenePainter::draw_points(sf::RenderTarget& target) {
+    if (lod_) {
+        if (density_sprite_) target.draw(*density_sprite_);
+    } else if (points_on_gpu_) {
+        target.draw(points_vb_);
+    } else {
+        target.draw(points_va_);
+    }
+}
+
+void ScenePainter::hull_lines(sf::VertexArray& va, const std::vector<core::Point>& pts, const core::HullFrame& fr) {
+    va.clear();
+    const std::size_t h = fr.hull_indices.size();
+    if (h < 2) return;
+    va.resize(2 * h);
+    for (std::size_t i = 0; i < h; ++i) {
+        const core::Point& a = pts[fr.hull_indices[i]];
+        const core::Point& b = pts[fr.hull_indices[(i + 1) % h]];
+        va[2 * i]     = sf::Vertex{sf::Vector2f(a.x, a.y), color_hull()};
+        va[2 * i + 1] = sf::Vertex{sf::Vector2f(b.x, b.y), color_hull()};
+    }
+}
+
+void ScenePainter::draw_hull(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr) {
+    const bool hull_changed = hull_dirty_ || fr.hull_indices != hull_cached_;
+    if (hull_changed) {
+        hull_cached_ = fr.hull_indices;
+        hull_dirty_ = false;
+        hull_lines(hull_va_, pts, fr);
+    }
+    target.draw(hull_va_);
+
+    // in the heatmap the hull vertices and the points around the active edge
+    // are still drawn one by one, so the cost follows the pixels and not n
+    if (lod_) {
+        if (hull_changed || fr.active_a != detail_a_ || fr.active_b != detail_b_) {
+            detail_a_ = fr.active_a;
+            detail_b_ = fr.active_b;
+            near_ids_.clear();
+            const int n = static_cast<int>(pts.size());
+            if (fr.active_a >= 0 && fr.active_a < n && fr.active_b >= 0 && fr.active_b < n) {
+                density_.points_near_segment(pts, pts[fr.active_a], pts[fr.active_b], 12.0f, 50000, near_ids_);
+            }
+            const std::size_t h = fr.hull_indices.size();
+            detail_va_.resize(6 * (near_ids_.size() + h));
+            std::size_t slot = 0;
+            for (int id : near_ids_) put_dot(detail_va_, slot++, pts[id].x, pts[id].y, color_point());
+            for (int id : fr.hull_indices) put_dot(detail_va_, slot++, pts[id].x, pts[id].y, color_hull());
+        }
+        target.draw(detail_va_);
+    }
+}
+
+// active markers are an overlay on top of the batched geometry
+void ScenePainter::draw_marks(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr) {
+    auto draw_mark = [&](int idx, sf::Color c) {
+        if (idx < 0 || idx >= static_cast<int>(pts.size())) return;
+        sf::CircleShape mark(6.0f);
+        mark.setPosition({pts[idx].x - 6.0f, pts[idx].y - 6.0f});
+        mark.setFillColor(c);
+        target.draw(mark);
+    };
+    draw_mark(fr.active_a, color_a());
+    draw_mark(fr.active_b, color_b());
+    draw_mark(fr.active_c, color_c());
+}
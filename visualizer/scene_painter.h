@@ -0,0 +1,48 @@
+#ifndef VIZ_SCENE_PAINTER_H
+#define VIZ_SCENE_PAINTER_H
+
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <vector>
+#include "core/types.h"
+#include "visualizer/density_map.h"
+
+// draws the point set, the hull of a frame and its active markers into any
+// render target, so the window and the offline renderer share one look.
+// geometry is batched and only rebuilt when the points or the hull change
+class ScenePainter {
+public:
+    // lod replaces the per point dots with a density heatmap of the given size
+    void set_points(const std::vector<core::Point>& pts, sf::Vector2u size, bool lod);
+
+    void draw(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr);
+
+    void draw_points(sf::RenderTarget& target);
+    void draw_hull(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr);
+    void draw_marks(sf::RenderTarget& target, const std::vector<core::Point>& pts, const core::HullFrame& fr);
+
+    // closed hull outline of fr as line pairs, for callers that keep their own batch
+    static void hull_lines(sf::VertexArray& va, const std::vector<core::Point>& pts, const core::HullFrame& fr);
+
+private:
+    sf::VertexBuffer points_vb_{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+    sf::VertexArray points_va_{sf::PrimitiveType::Triangles};
+    bool points_on_gpu_{false};
+    sf::VertexArray hull_va_{sf::PrimitiveType::Lines};
+    std::vector<int> hull_cached_;
+    bool hull_dirty_{true};
+
+    // level of detail for large point sets, the heatmap is built once per
+    // point set and only hull vertices and points near the active edge are
+    // drawn one by one
+    bool lod_{false};
+    DensityMap density_;
+    sf::Texture density_tex_;
+    std::optional<sf::Sprite> density_sprite_;
+    sf::VertexArray detail_va_{sf::PrimitiveType::Triangles};
+    std::vector<int> near_ids_;
+    int detail_a_{-2};
+    int detail_b_{-2};
+};
+
+#endif
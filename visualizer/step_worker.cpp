@@ -0,0 +1,94 @@
+#include "visualizer/step_worker.h"
+#include "core/stopwatch.h"
+#include <chrono>
+#include <exception>
+#include <optional>
+
+StepWorker::StepWorker(std::unique_ptr<ConvexHullAlgorithm> algo, std::vector<core::Point> pts, bool stepping,
+                       io::HullCache* cache, std::uint64_t input)
+    : algo_(std::move(algo)),
+      points_(std::move(pts)),
+      cache_(input != 0 ? cache : nullptr),
+      input_(input) {
+    thread_ = std::thread([this, stepping] { main(stepping); });
+}
+
+StepWorker::~StepWorker() {
+    cancel();
+    if (thread_.joinable()) thread_.join();
+}
+
+void StepWorker::cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+    stop_.request_stop();
+}
+
+bool StepWorker::pop(core::HullFrame& out) {
+    return frames_.try_pop(out);
+}
+
+bool StepWorker::publish(core::HullFrame fr) {
+    // the queue is bounded so a slow ui holds the producer back
+    while (!frames_.try_push(std::move(fr))) {
+        if (cancel_.load(std::memory_order_relaxed)) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    produced_.fetch_add(1, std::memory_order_relaxed);
+    return !cancel_.load(std::memory_order_relaxed);
+}
+
+void StepWorker::main(bool stepping) {
+    try {
+        Stopwatch sw;
+        sw.start();
+        if (stepping) {
+            algo_->reset(points_);
+            algo_->begin_stepping();
+            sw.stop();
+            run_ns_.store(sw.ns(), std::memory_order_relaxed);
+            phase_.store(Phase::Streaming, std::memory_order_release);
+            // step moves onto the last frame as it returns false, that one
+            // goes out as well. a single frame has nowhere to move to
+            bool more = publish(algo_->frame()) && algo_->frame_count() > 1;
+            while (more) {
+                more = algo_->step();
+                if (!publish(algo_->frame())) break;
+            }
+        } else {
+            const std::uint64_t key = cache_ ? io::hull_hash(input_, algo_->name()) : 0;
+            std::optional<io::CachedHull> hit;
+            if (cache_) hit = cache_->find_hull(key, points_.size());
+            std::vector<int> hull;
+            if (hit) {
+                hull = hit->to_vector();
+            } else {
+                algo_->reset(points_);
+                hull = algo_->run_cancellable(stop_.get_token());
+            }
+            sw.stop();
+            run_ns_.store(sw.ns(), std::memory_order_relaxed);
+            if (cache_ && !hit) {
+                try {
+                    cache_->store_hull(key, hull);
+                } catch (const std::exception&) {
+                    // computed again next time
+                }
+            }
+            phase_.store(Phase::Streaming, std::memory_order_release);
+
+            core::HullFrame fr;
+            fr.kind = core::StepKind::Done;
+            fr.hull_indices = std::move(hull);
+            fr.label = hit ? "Done, from cache" : "Done";
+            publish(std::move(fr));
+        }
+    } catch (const HullCancelled&) {
+        // nobody is waiting for the hull any more
+    } catch (const std::exception& e) {
+        core::HullFrame fr;
+        fr.kind = core::StepKind::Done;
+        fr.label = std::string("error: ") + e.what();
+        publish(std::move(fr));
+    }
+    phase_.store(Phase::Finished, std::memory_order_release);
+}
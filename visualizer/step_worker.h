@@ -0,0 +1,67 @@
+#ifndef VIZ_STEP_WORKER_H
+#define VIZ_STEP_WORKER_H
+
+#include <atomic>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include "algorithms/convex_hull_algorithm.h"
+#include "core/spsc_queue.h"
+#include "core/types.h"
+#include "io/hull_cache.h"
+
+// runs one algorithm on its own thread and streams its frames to the ui
+// through a lock free queue. in stepping mode every frame is published, in
+// full mode the hull is computed with run_full and published as one Done
+// frame. given a cache and the points_hash of the input, full mode takes the
+// hull from the cache when it is there and stores it otherwise. the ui only
+// ever calls pop, so it never waits on the algorithm
+class StepWorker {
+public:
+    enum class Phase { Computing, Streaming, Finished };
+
+    StepWorker(std::unique_ptr<ConvexHullAlgorithm> algo, std::vector<core::Point> pts, bool stepping,
+               io::HullCache* cache = nullptr, std::uint64_t input = 0);
+    ~StepWorker(); // cancels and joins
+    StepWorker(const StepWorker&) = delete;
+    StepWorker& operator=(const StepWorker&) = delete;
+
+    // ask the thread to stop at the next frame boundary. a run_full in
+    // progress stops at its next checkpoint, a begin_stepping still runs to
+    // its end
+    void cancel();
+
+    // consumer side, false when no frame is ready right now
+    bool pop(core::HullFrame& out);
+
+    Phase phase() const { return phase_.load(std::memory_order_acquire); }
+    // the thread has returned, joining it will not block
+    bool finished() const { return phase() == Phase::Finished; }
+    // finished and every frame consumed
+    bool drained() const { return finished() && frames_.empty(); }
+
+    std::size_t produced() const { return produced_.load(std::memory_order_relaxed); }
+    // time spent inside the algorithm, valid once streaming starts
+    double run_ms() const { return static_cast<double>(run_ns_.load(std::memory_order_relaxed)) / 1e6; }
+
+private:
+    std::unique_ptr<ConvexHullAlgorithm> algo_;
+    std::vector<core::Point> points_;
+    io::HullCache* cache_;
+    std::uint64_t input_;
+    core::SpscQueue<core::HullFrame> frames_{1024};
+
+    std::atomic<Phase> phase_{Phase::Computing};
+    std::atomic<bool> cancel_{false};
+    std::stop_source stop_;
+    std::atomic<std::size_t> produced_{0};
+    std::atomic<long long> run_ns_{0};
+    std::thread thread_;
+
+    void main(bool stepping);
+    bool publish(core::HullFrame fr); // false when cancelled
+};
+
+#endif